@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host micro-benchmark for the frame buffer blitter.
+ *
+ * Runs each Blitter operation on a 128x64 buffer next to the loop it replaces
+ * (the per-byte fade masks from the old renderer, u8g2 box drawing, byte
+ * copies), checks that both produce the same buffer, and reports the cost of
+ * one call.
+ */
+
+#include "core/blit/blitter.h"
+#include "U8g2lib.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+namespace {
+
+constexpr int ITERATIONS = 20000;
+constexpr size_t BUFFER_SIZE = 1024;
+constexpr uint8_t TILE_WIDTH = 16;
+
+class NullU8G2 : public U8G2 {
+public:
+    NullU8G2() {
+        u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+    }
+};
+
+NullU8G2 display;
+uint8_t g_source[BUFFER_SIZE];
+uint8_t g_reference[BUFFER_SIZE];
+
+uint64_t timestamp() {
+#ifdef BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Fills buf with the same pseudo random content before every run.
+void seed(uint8_t* buf) {
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+        state = state * 1664525 + 1013904223;
+        buf[i] = state >> 24;
+    }
+}
+
+// Returns timestamp ticks per call of op on buf.
+template <typename Op>
+double measure(uint8_t* buf, Op op) {
+    seed(buf);
+    uint64_t start = timestamp();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        op(buf);
+    }
+    uint64_t end = timestamp();
+    return static_cast<double>(end - start) / ITERATIONS;
+}
+
+struct Case {
+    const char* name;
+    void (*before)(uint8_t* buf);
+    void (*after)(uint8_t* buf);
+};
+
+// old fade pass 1 of renderer()
+void maskBytes(uint8_t* buf) {
+    for (uint16_t i = 0; i < BUFFER_SIZE; ++i) if (i % 2 != 0) buf[i] = buf[i] & 0xAA;
+}
+void maskBlit(uint8_t* buf) {
+    Blitter::mask(buf, BUFFER_SIZE, 0xFF, 0xAA);
+}
+
+void blendBytes(uint8_t* buf) {
+    for (uint16_t i = 0; i < BUFFER_SIZE; ++i) {
+        if (i % 2 != 0) buf[i] = (g_source[i] & 0xAA) | (buf[i] & 0x55);
+        else buf[i] = g_source[i];
+    }
+}
+void blendBlit(uint8_t* buf) {
+    Blitter::blend(buf, g_source, BUFFER_SIZE, 0x00, 0x55);
+}
+
+// the u8g2 calls run on display's own buffer, which the harness points at buf
+void clearU8g2(uint8_t*) {
+    display.setDrawColor(0);
+    display.drawBox(32, 16, 64, 32);
+    display.setDrawColor(1);
+}
+void clearBlit(uint8_t* buf) {
+    Blitter::fillRect(buf, TILE_WIDTH, 32, 2, 64, 4, 0);
+}
+
+void invertU8g2(uint8_t*) {
+    display.setDrawColor(2);
+    display.drawBox(0, 0, 128, 64);
+    display.setDrawColor(1);
+}
+void invertBlit(uint8_t* buf) {
+    Blitter::invertRect(buf, TILE_WIDTH, 0, 0, 128, 8);
+}
+
+void copyBytes(uint8_t* buf) {
+    for (int page = 2; page < 6; ++page)
+        for (int x = 32; x < 96; ++x) buf[page * 128 + x] = g_source[page * 128 + x];
+}
+void copyBlit(uint8_t* buf) {
+    Blitter::copyRect(buf, g_source, TILE_WIDTH, 32, 2, 64, 4);
+}
+
+const Case CASES[] = {
+    { "fade mask",      maskBytes,  maskBlit },
+    { "dither blend",   blendBytes, blendBlit },
+    { "clear 64x32",    clearU8g2,  clearBlit },
+    { "invert 128x64",  invertU8g2, invertBlit },
+    { "copy 64x32",     copyBytes,  copyBlit },
+};
+
+} // namespace
+
+int main() {
+#ifdef BENCH_HAS_TSC
+    const char* unit = "cycles";
+#else
+    const char* unit = "ns";
+#endif
+
+    display.begin();
+    uint8_t* buf = display.getBufferPtr();
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) g_source[i] = (uint8_t)(i * 7);
+
+    std::printf("blitter: 128x64 buffer, %d calls per case\n", ITERATIONS);
+    std::printf("%-16s %12s %12s %9s\n", "case", "byte loop", "blitter", "speedup");
+
+    bool ok = true;
+    for (const Case& c : CASES) {
+        seed(buf);
+        c.before(buf);
+        memcpy(g_reference, buf, BUFFER_SIZE);
+        seed(buf);
+        c.after(buf);
+        bool same = !memcmp(g_reference, buf, BUFFER_SIZE);
+        ok = ok && same;
+
+        double before = measure(buf, c.before);
+        double after = measure(buf, c.after);
+        std::printf("%-16s %9.1f %-2s %9.1f %-2s %8.1fx%s\n", c.name, before, unit, after, unit,
+                    after > 0 ? before / after : 0.0, same ? "" : "  MISMATCH");
+    }
+
+    if (!ok) {
+        std::printf("error: blitter output differs from the reference loop\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host benchmark for the easing kernels.
+ *
+ * For every easing type, measures the cost of one evaluation with the exact
+ * fixed-point math and with the compile-time lookup tables, and reports the
+ * worst-case difference between the two over the whole [0, 1] range.
+ */
+
+#include "core/animation/animation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+namespace {
+
+// Distance used to express the table error in pixels, the width of the screen.
+constexpr int32_t MOVE_DISTANCE_PX = 128;
+constexpr int ITERATIONS = 200;
+
+const char* easingName(EasingType type) {
+    switch (type) {
+        case EasingType::LINEAR:            return "LINEAR";
+        case EasingType::EASE_IN_QUAD:      return "EASE_IN_QUAD";
+        case EasingType::EASE_OUT_QUAD:     return "EASE_OUT_QUAD";
+        case EasingType::EASE_IN_OUT_QUAD:  return "EASE_IN_OUT_QUAD";
+        case EasingType::EASE_IN_CUBIC:     return "EASE_IN_CUBIC";
+        case EasingType::EASE_OUT_CUBIC:    return "EASE_OUT_CUBIC";
+        case EasingType::EASE_IN_OUT_CUBIC: return "EASE_IN_OUT_CUBIC";
+        case EasingType::EASE_OUT_BOUNCE:   return "EASE_OUT_BOUNCE";
+        default:                            return "?";
+    }
+}
+
+uint64_t timestamp() {
+#ifdef BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Sweeps t over [0, 1] ITERATIONS times and returns timestamp ticks per evaluation.
+template <typename Kernel>
+double measure(EasingType type, Kernel kernel) {
+    volatile int32_t sink = 0;
+    uint64_t start = timestamp();
+    for (int iter = 0; iter < ITERATIONS; ++iter) {
+        int32_t acc = 0;
+        for (int32_t t = 0; t <= FIXED_POINT_ONE; ++t) {
+            acc += kernel(type, t);
+        }
+        sink = sink + acc;
+    }
+    uint64_t end = timestamp();
+    return static_cast<double>(end - start) / (static_cast<double>(ITERATIONS) * (FIXED_POINT_ONE + 1));
+}
+
+} // namespace
+
+int main() {
+#ifdef BENCH_HAS_TSC
+    const char* unit = "cycles";
+#else
+    const char* unit = "ns";
+#endif
+
+    std::printf("easing kernels: %d-entry tables, %d evaluations per type\n",
+                EASING_LUT_SIZE + 1, ITERATIONS * (FIXED_POINT_ONE + 1));
+    std::printf("%-18s %12s %12s %14s %14s\n", "type", "exact", "lut", "max err (lsb)", "max err (px)");
+
+    bool ok = true;
+    for (int i = 0; i < EASING_TYPE_COUNT; ++i) {
+        EasingType type = static_cast<EasingType>(i);
+
+        int32_t maxError = 0;
+        int32_t maxPixelError = 0;
+        for (int32_t t = 0; t <= FIXED_POINT_ONE; ++t) {
+            int32_t exact = EasingCalculator::calculateExact(type, t);
+            int32_t lut = EasingCalculator::calculateLut(type, t);
+            maxError = std::max(maxError, std::abs(exact - lut));
+
+            int32_t exactPx = (MOVE_DISTANCE_PX * exact) >> SHIFT_BITS;
+            int32_t lutPx = (MOVE_DISTANCE_PX * lut) >> SHIFT_BITS;
+            maxPixelError = std::max(maxPixelError, std::abs(exactPx - lutPx));
+        }
+        if (EasingCalculator::calculateLut(type, FIXED_POINT_ONE) != EasingCalculator::calculateExact(type, FIXED_POINT_ONE)) {
+            ok = false;
+        }
+
+        double exactCost = measure(type, EasingCalculator::calculateExact);
+        double lutCost = measure(type, EasingCalculator::calculateLut);
+
+        std::printf("%-18s %9.2f %-2s %9.2f %-2s %14d %14d\n", easingName(type),
+                    exactCost, unit, lutCost, unit, maxError, maxPixelError);
+    }
+
+    if (!ok) {
+        std::printf("error: table end points do not match the exact math\n");
+        return 1;
+    }
+    return 0;
+}
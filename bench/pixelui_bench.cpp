@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Headless end-to-end frame benchmark.
+ *
+ * Drives the real applications from examples/ through scripted input on a
+ * U8G2 display whose byte callback discards everything, and reports per
+ * scene how long Heartbeat and renderer take, how many low level draw calls
+ * and heap allocations a frame costs, how many 8x8 display tiles it sends,
+ * and the peak number of animations.
+ *
+ * With --golden DIR every scene is also checked against DIR/<scene>.pbm, see
+ * "Golden frames" below; --update-golden DIR writes those files instead. The
+ * exit status is non-zero when a frame differs or a scene got more expensive.
+ *
+ * --glyph-cache BYTES draws text through a glyph cache of that size and prints its
+ * hit, miss and flush counts at the end. The cache only blits into an unhooked u8g2
+ * buffer, so draw calls are not counted then.
+ *
+ * usage: pixelui_bench [repeat] [--tile-diff] [--glyph-cache BYTES] [--golden DIR | --update-golden DIR] [--time-budget PCT]
+ */
+
+#include "PixelUI.h"
+#include "ui/AppView/AppView.h"
+#include "core/ViewManager/ViewManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// -------------------------------
+// Heap allocation counter
+// -------------------------------
+static size_t g_allocCount = 0;
+static size_t g_allocMark = 0; // allocations up to the end of the previous frame
+
+void* operator new(size_t size) {
+    ++g_allocCount;
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+// -------------------------------
+// Null display with a draw call counter
+// -------------------------------
+class NullU8G2 : public U8G2 {
+public:
+    NullU8G2() {
+        u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+    }
+};
+
+static size_t g_drawCalls = 0;
+static u8g2_draw_ll_hvline_cb g_hvline = nullptr;
+
+// every pixel run of every primitive and glyph ends up here
+static void countingHvline(u8g2_t* u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    ++g_drawCalls;
+    g_hvline(u8g2, x, y, len, dir);
+}
+
+NullU8G2 display;
+PixelUI ui(display); // examples/ListViewDemo1.cpp refers to this one
+
+static void noDelay(uint32_t) {}
+
+// -------------------------------
+// Scenes
+// -------------------------------
+#define FRAME_MS 16
+
+/*
+ * Script language, one character per step:
+ *   U D L R S B  inject an input event, then run 4 frames
+ *   .            run 1 frame
+ *   -            run 16 frames (~256 ms)
+ * Every scene starts and ends on the AppView home screen.
+ */
+struct Scene {
+    const char* name;
+    const char* script;
+};
+
+static const Scene SCENES[] = {
+    { "appview",  "RRR.RRR.---LLLLLL---" },
+    { "listview", "L-S---DDR--DDL--DR--R--DDDDDDD--UUUUUUUUU--B---R---" },
+    { "popup",    "L-S---DR----S---R-----------DDDR--RRRRRLL-----------------------------------B---R---" },
+    { "counter",  "S----------------RRRLLS---B---" },
+};
+
+struct Stats {
+    size_t frames = 0;
+    uint64_t heartbeatNs = 0;
+    uint64_t heartbeatMaxNs = 0;
+    uint64_t rendererNs = 0;
+    uint64_t rendererMaxNs = 0;
+    size_t drawCalls = 0;
+    size_t drawCallsMax = 0;
+    size_t allocs = 0;
+    size_t allocsMax = 0;
+    size_t tiles = 0;
+    size_t tilesMax = 0;
+    uint32_t peakAnimations = 0;
+};
+
+// -------------------------------
+// Golden frames
+// -------------------------------
+/*
+ * A scene's golden is one PBM image holding the frame at the end of every script
+ * step, stacked top to bottom, so it opens in any image viewer. Its header comments
+ * carry a checksum over every frame of the scene (intermediate frames included) and
+ * the work the scene took: draw calls and tiles must not grow, and with
+ * --time-budget the renderer time may not exceed the golden's by more than PCT %.
+ */
+struct Capture {
+    std::vector<uint8_t> pixels;                // PBM rows of the step frames
+    uint32_t height = 0;
+    uint64_t checksum = 1469598103934665603ull; // FNV-1a over every frame
+};
+
+struct Golden {
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0, height = 0;
+    uint64_t checksum = 0;
+    size_t drawCalls = 0, tiles = 0;
+    uint64_t rendererNs = 0;
+};
+
+static Capture* g_capture = nullptr;
+
+static void checksumFrame(Capture& capture) {
+    const uint8_t* buffer = display.getBufferPtr();
+    size_t size = (size_t)display.getBufferTileWidth() * display.getBufferTileHeight() * 8;
+    for (size_t i = 0; i < size; ++i) {
+        capture.checksum = (capture.checksum ^ buffer[i]) * 1099511628211ull;
+    }
+}
+
+// u8g2 pages (8 rows, one byte per column, LSB on top) to PBM rows (MSB on the left)
+static void captureFrame(Capture& capture) {
+    const uint8_t* buffer = display.getBufferPtr();
+    const int width = display.getBufferTileWidth() * 8;
+    const int height = display.getBufferTileHeight() * 8;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* page = buffer + (y / 8) * width;
+        for (int x = 0; x < width; x += 8) {
+            uint8_t packed = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                if ((page[x + bit] >> (y % 8)) & 1) packed |= 0x80 >> bit;
+            }
+            capture.pixels.push_back(packed);
+        }
+    }
+    capture.height += height;
+}
+
+static bool writeGolden(const std::string& path, const Capture& capture, const Golden& stats) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fprintf(file, "P4\n# pixelui checksum %016llx\n# pixelui calls %zu tiles %zu renderer_ns %llu\n%d %u\n",
+                 (unsigned long long)capture.checksum, stats.drawCalls, stats.tiles,
+                 (unsigned long long)stats.rendererNs, display.getBufferTileWidth() * 8, capture.height);
+    std::fwrite(capture.pixels.data(), 1, capture.pixels.size(), file);
+    return std::fclose(file) == 0;
+}
+
+static bool readGolden(const std::string& path, Golden& golden) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    char line[128];
+    bool ok = std::fgets(line, sizeof(line), file) && !std::strncmp(line, "P4", 2);
+    while (ok && std::fgets(line, sizeof(line), file) && line[0] == '#') {
+        unsigned long long checksum, ns;
+        if (std::sscanf(line, "# pixelui checksum %llx", &checksum) == 1) golden.checksum = checksum;
+        if (std::sscanf(line, "# pixelui calls %zu tiles %zu renderer_ns %llu", &golden.drawCalls, &golden.tiles, &ns) == 3) {
+            golden.rendererNs = ns;
+        }
+    }
+    ok = ok && std::sscanf(line, "%u %u", &golden.width, &golden.height) == 2;
+    if (ok) {
+        golden.pixels.resize((size_t)(golden.width + 7) / 8 * golden.height);
+        ok = std::fread(golden.pixels.data(), 1, golden.pixels.size(), file) == golden.pixels.size();
+    }
+    std::fclose(file);
+    return ok;
+}
+
+static uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void runFrame(Stats& stats) {
+    size_t drawCallsBefore = g_drawCalls;
+    uint32_t tilesBefore = ui.getFrameStats().tilesSent;
+
+    uint64_t start = nowNs();
+    ui.Heartbeat(FRAME_MS);
+    uint64_t mid = nowNs();
+    ui.renderer();
+    uint64_t end = nowNs();
+    if (g_capture) checksumFrame(*g_capture);
+
+    // input handled since the last frame is charged to this one
+    size_t allocs = g_allocCount - g_allocMark;
+    g_allocMark = g_allocCount;
+    size_t drawCalls = g_drawCalls - drawCallsBefore;
+    size_t tiles = ui.getFrameStats().tilesSent - tilesBefore;
+
+    stats.frames++;
+    stats.heartbeatNs += mid - start;
+    stats.heartbeatMaxNs = std::max(stats.heartbeatMaxNs, mid - start);
+    stats.rendererNs += end - mid;
+    stats.rendererMaxNs = std::max(stats.rendererMaxNs, end - mid);
+    stats.drawCalls += drawCalls;
+    stats.drawCallsMax = std::max(stats.drawCallsMax, drawCalls);
+    stats.allocs += allocs;
+    stats.allocsMax = std::max(stats.allocsMax, allocs);
+    stats.tiles += tiles;
+    stats.tilesMax = std::max(stats.tilesMax, tiles);
+    stats.peakAnimations = std::max(stats.peakAnimations, ui.getActiveAnimationCount());
+}
+
+static void runScript(const char* script, Stats& stats) {
+    for (const char* step = script; *step; ++step) {
+        int frames = 4;
+        switch (*step) {
+            case 'U': ui.handleInput(InputEvent::UP); break;
+            case 'D': ui.handleInput(InputEvent::DOWN); break;
+            case 'L': ui.handleInput(InputEvent::LEFT); break;
+            case 'R': ui.handleInput(InputEvent::RIGHT); break;
+            case 'S': ui.handleInput(InputEvent::SELECT); break;
+            case 'B': ui.handleInput(InputEvent::BACK); break;
+            case '.': frames = 1; break;
+            case '-': frames = 16; break;
+            default:  frames = 0; break;
+        }
+        for (int i = 0; i < frames; ++i) {
+            runFrame(stats);
+        }
+        if (g_capture && frames) captureFrame(*g_capture);
+    }
+}
+
+/**
+ * @brief Compares a scene with its golden.
+ * @return false on a pixel difference or a regression in work.
+ */
+static bool checkGolden(const std::string& path, const char* script, const Capture& capture,
+                        const Stats& stats, int timeBudget) {
+    Golden golden;
+    if (!readGolden(path, golden)) {
+        std::printf("  FAIL %s: missing or unreadable, create it with --update-golden\n", path.c_str());
+        return false;
+    }
+    bool ok = true;
+    if (golden.pixels != capture.pixels) {
+        // name the first script step whose frame differs
+        size_t frameBytes = (size_t)display.getBufferTileWidth() * display.getBufferTileHeight() * 8;
+        size_t i = 0;
+        while (i < golden.pixels.size() && i < capture.pixels.size() && golden.pixels[i] == capture.pixels[i]) ++i;
+        size_t frame = i / frameBytes;
+        const char* step = script;
+        for (size_t n = 0; *step; ++step) {
+            if (!std::strchr("UDLRSB.-", *step)) continue;
+            if (n++ == frame) break;
+        }
+        std::string actual = path.substr(0, path.size() - 4) + ".actual.pbm";
+        writeGolden(actual, capture, Golden{});
+        std::printf("  FAIL frame after step %zu ('%c') differs, see %s\n", frame, *step ? *step : '?', actual.c_str());
+        ok = false;
+    } else if (golden.checksum != capture.checksum) {
+        std::printf("  FAIL an intermediate frame differs (checksum %016llx, golden %016llx)\n",
+                    (unsigned long long)capture.checksum, (unsigned long long)golden.checksum);
+        ok = false;
+    }
+    if (stats.drawCalls > golden.drawCalls || stats.tiles > golden.tiles) {
+        std::printf("  FAIL more work: %zu draw calls, %zu tiles (golden %zu, %zu)\n",
+                    stats.drawCalls, stats.tiles, golden.drawCalls, golden.tiles);
+        ok = false;
+    }
+    if (timeBudget >= 0 && golden.rendererNs
+        && stats.rendererNs * 100 > golden.rendererNs * (100 + (uint64_t)timeBudget)) {
+        std::printf("  FAIL renderer took %llu ns, golden %llu ns + %d %%\n", (unsigned long long)stats.rendererNs,
+                    (unsigned long long)golden.rendererNs, timeBudget);
+        ok = false;
+    }
+    return ok;
+}
+
+static void printStats(const char* name, const Stats& stats) {
+    size_t frames = stats.frames ? stats.frames : 1;
+    std::printf("%-10s %7zu %9llu %9llu %9llu %9llu %8zu %8zu %7.2f %6zu %6zu %6zu %6u\n", name, stats.frames,
+                (unsigned long long)(stats.heartbeatNs / frames), (unsigned long long)stats.heartbeatMaxNs,
+                (unsigned long long)(stats.rendererNs / frames), (unsigned long long)stats.rendererMaxNs,
+                stats.drawCalls / frames, stats.drawCallsMax,
+                (double)stats.allocs / frames, stats.allocsMax,
+                stats.tiles / frames, stats.tilesMax, stats.peakAnimations);
+}
+
+int main(int argc, char** argv) {
+    int repeat = 1;
+    bool tileDiff = false;
+    const char* goldenDir = nullptr;
+    bool updateGolden = false;
+    int timeBudget = -1;
+    int glyphCache = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--tile-diff")) tileDiff = true;
+        else if (!std::strcmp(argv[i], "--golden") && i + 1 < argc) goldenDir = argv[++i];
+        else if (!std::strcmp(argv[i], "--update-golden") && i + 1 < argc) { goldenDir = argv[++i]; updateGolden = true; }
+        else if (!std::strcmp(argv[i], "--time-budget") && i + 1 < argc) timeBudget = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--glyph-cache") && i + 1 < argc) glyphCache = std::atoi(argv[++i]);
+        else repeat = std::atoi(argv[i]);
+    }
+    if (repeat < 1 || goldenDir) repeat = 1; // goldens hold a single pass
+
+    display.begin();
+    g_hvline = display.getU8g2()->ll_hvline;
+    if (glyphCache <= 0) display.getU8g2()->ll_hvline = countingHvline;
+
+    ui.setDelayFunction(noDelay);
+    ui.begin();
+    if (tileDiff) ui.setFlushMode(FlushMode::TILE_DIFF);
+    if (glyphCache > 0) ui.getGlyphCache().setBudget(glyphCache);
+    auto appView = std::make_shared<AppView>(ui, *ui.getViewManagerPtr());
+    ui.getViewManagerPtr()->push(appView);
+
+    // settle the home screen so its intro animations do not count against the first scene
+    Stats warmup;
+    runScript("----", warmup);
+    g_allocMark = g_allocCount;
+
+    std::printf("%-10s %7s %9s %9s %9s %9s %8s %8s %7s %6s %6s %6s %6s\n", "scene", "frames",
+                "hb ns", "hb max", "draw ns", "draw max", "calls", "max", "allocs", "max", "tiles", "max", "anims");
+
+    Stats total;
+    bool passed = true;
+    for (const Scene& scene : SCENES) {
+        Stats stats;
+        Capture capture;
+        g_capture = goldenDir ? &capture : nullptr;
+        for (int i = 0; i < repeat; ++i) {
+            runScript(scene.script, stats);
+        }
+        g_capture = nullptr;
+        printStats(scene.name, stats);
+
+        if (goldenDir) {
+            std::string path = std::string(goldenDir) + "/" + scene.name + ".pbm";
+            if (updateGolden) {
+                Golden work;
+                work.drawCalls = stats.drawCalls;
+                work.tiles = stats.tiles;
+                work.rendererNs = stats.rendererNs;
+                if (!writeGolden(path, capture, work)) {
+                    std::printf("  FAIL cannot write %s\n", path.c_str());
+                    passed = false;
+                }
+            } else {
+                passed &= checkGolden(path, scene.script, capture, stats, timeBudget);
+            }
+        }
+
+        total.frames += stats.frames;
+        total.heartbeatNs += stats.heartbeatNs;
+        total.heartbeatMaxNs = std::max(total.heartbeatMaxNs, stats.heartbeatMaxNs);
+        total.rendererNs += stats.rendererNs;
+        total.rendererMaxNs = std::max(total.rendererMaxNs, stats.rendererMaxNs);
+        total.drawCalls += stats.drawCalls;
+        total.drawCallsMax = std::max(total.drawCallsMax, stats.drawCallsMax);
+        total.allocs += stats.allocs;
+        total.allocsMax = std::max(total.allocsMax, stats.allocsMax);
+        total.tiles += stats.tiles;
+        total.tilesMax = std::max(total.tilesMax, stats.tilesMax);
+        total.peakAnimations = std::max(total.peakAnimations, stats.peakAnimations);
+    }
+    printStats("total", total);
+    if (glyphCache > 0) {
+        const GlyphCache::Stats& cache = ui.getGlyphCache().getStats();
+        std::printf("glyph cache: %zu of %d bytes, %u hits, %u misses, %u flushes\n", cache.bytesUsed, glyphCache,
+                    cache.hits, cache.misses, cache.flushes);
+    }
+    if (goldenDir && !updateGolden) std::printf("golden frames: %s\n", passed ? "PASS" : "FAIL");
+    return passed ? 0 : 1;
+}
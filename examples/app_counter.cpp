@@ -23,6 +23,7 @@
 #include "widgets/brace/brace.h"
 #include "widgets/iconButton/iconButton.h"
 #include "focus/focus.h"
+#include "core/layer/layer.h"
 
 static const unsigned char image_info_bits[] = {
     0xf0,0xff,0x0f,0xfc,0xff,0x3f,0xfe,0xff,0x7f,0xfe,0xff,0x7f,0xff,0x81,0xff,0xff,0x00,0xff,0x7f,0x3e,0xff,0x7f,0x3f,0xff,0xff,0x3f,0xff,0xff,0x1f,0xff,0xff,0x8f,0xff,0xff,0xc7,0xff,0xff,0xe3,0xff,0xff,0xe3,0xff,0xff,0xe3,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xe3,0xff,0xff,0xe3,0xff,0xff,0xff,0xff,0xfe,0xff,0x7f,0xfe,0xff,0x7f,0xfc,0xff,0x3f,0xf0,0xff,0x0f
@@ -57,23 +58,15 @@ private:
     Histogram histogram;
     Brace brace;
     FocusManager m_focusMan;
+    Layer m_background;
 
     IconButton icon_battery;
     IconButton icon_alert;
     IconButton icon_sounding;
     IconButton icon_alarm;
 
-    // State machine for loading animation sequence
-    enum class LoadState {
-        INIT,          // start
-        BRACE_LOADING, // execute brace.onLoad()
-        WAIT_HISTO,    // wait 300ms
-        HISTO_LOADING, // execute histogram.onLoad()
-        DONE           // all done
-    } loadState = LoadState::INIT;
-
-    uint32_t state_timestamp = 0;  // record time when entering a state
-    bool first_time = false;
+    // Loading animation sequence
+    Timeline m_loadTimeline;
 
     // animation related variables
     int32_t anim_mark_m = 0;
@@ -85,6 +78,7 @@ public:
     histogram(ui), 
     brace(ui), 
     m_focusMan(ui), 
+    m_background(ui),
     icon_sounding(ui),
     icon_battery(ui),
     icon_alarm(ui),
@@ -94,7 +88,11 @@ public:
     void onEnter(ExitCallback cb) override {
         IApplication::onEnter(cb);
 
-        m_ui.setContinousDraw(true);
+        // the background frame never changes, rasterize it once
+        m_background.setBounds(0, 7, 128, 10);
+        m_background.setPaint([](U8G2& u8g2) {
+            u8g2.drawXBM(0, 7, 128, 10, image_Background_bits);
+        });
 
         // HISTOGRAM
         histogram.setCoordinate(97,54);
@@ -132,8 +130,22 @@ public:
         m_focusMan.addWidget(&brace);
         m_focusMan.addWidget(&histogram);  
 
-        loadState = LoadState::INIT;
-        first_time = false;
+        // brace and the first icons load right away, the rest follows 80ms later
+        m_loadTimeline.clear()
+            .add(anim_mark_m, 23, 300, EasingType::EASE_OUT_QUAD)
+            .add(anim_bg, 128, 500, EasingType::EASE_IN_OUT_CUBIC)
+            .call([this]() {
+                brace.onLoad();
+                icon_battery.onLoad();
+                icon_alert.onLoad();
+            })
+            .call([this]() {
+                histogram.onLoad();
+                icon_sounding.onLoad();
+                icon_alarm.onLoad();
+            }, 80)
+            .add(anim_status_x, 29, 450, EasingType::EASE_OUT_CUBIC, 80);
+        m_ui.playTimeline(m_loadTimeline, PROTECTION::PROTECTED);
     }
 
     void braceContent() {
@@ -148,54 +160,10 @@ public:
     }
 
     void draw() override {
-        if (!first_time) {
-            m_ui.animate(anim_mark_m, 23, 300, EasingType::EASE_OUT_QUAD, PROTECTION::PROTECTED);
-            m_ui.animate(anim_bg, 128, 500, EasingType::EASE_IN_OUT_CUBIC, PROTECTION::PROTECTED);
-            
-            // the state machine start from its initial state
-            loadState = LoadState::BRACE_LOADING;
-            state_timestamp = m_ui.getCurrentTime();
-            first_time = true;
-        }
-
-        // state machine
-        switch (loadState) {
-            case LoadState::BRACE_LOADING:
-                brace.onLoad();
-
-                icon_battery.onLoad();
-                icon_alert.onLoad();
-
-                loadState = LoadState::WAIT_HISTO;
-                state_timestamp = m_ui.getCurrentTime(); // record when was the state entered
-                break;
-
-            case LoadState::WAIT_HISTO:
-                if (m_ui.getCurrentTime() - state_timestamp >= 80) {
-                    loadState = LoadState::HISTO_LOADING;
-                }
-                break;
-
-            case LoadState::HISTO_LOADING:
-                histogram.onLoad();
-                icon_sounding.onLoad();
-                icon_alarm.onLoad();
-                loadState = LoadState::DONE;
-                m_ui.animate(anim_status_x, 29, 450, EasingType::EASE_OUT_CUBIC, PROTECTION::PROTECTED);
-                break;
-
-            case LoadState::DONE:
-                // Do nothing, wait for exit
-                break;
-
-            default:
-                break;
-        }
-
         // UI drawing
         U8G2& u8g2 = m_ui.getU8G2();
         u8g2.setClipWindow(0,7,anim_bg,18);
-        u8g2.drawXBM(0, 7, 128, 10, image_Background_bits);
+        m_background.draw();
         u8g2.setMaxClipWindow();
         
         u8g2.setFont(u8g2_font_5x7_tr);
@@ -229,6 +197,10 @@ public:
         m_focusMan.draw();
     }
 
+    void update(uint32_t /*currentTime*/) override {
+        m_focusMan.update();
+    }
+
     bool handleInput(InputEvent event) override {
         // Check if a widget has taken over input control
         IWidget* activeWidget = m_focusMan.getActiveWidget();
@@ -256,8 +228,6 @@ public:
 
 
     void onExit() {
-        m_ui.clearAllAnimations();
-        m_ui.setContinousDraw(false);
         m_ui.markFading();
     }
 };
@@ -97,7 +97,6 @@ void drawCube(U8G2 &display, float angleX, float angleY) {
     }
 }
 
-static float angleX = 0, angleY = 0;
 static float height = 28;
 static bool state = 0;
 
@@ -105,20 +104,23 @@ static bool state = 0;
 class CubeDemo : public IApplication {
 private:
     PixelUI& m_ui;
+    uint32_t m_enterTime = 0;
 public:
     CubeDemo(PixelUI& ui):m_ui(ui) {};
     void draw() override {
-        m_ui.markDirty();
         U8G2& display = m_ui.getU8G2();
         
         display.setFont(u8g2_font_ncenB10_tr);
         display.drawStr(20, 20, "Cube Demo");
 
-        drawCube(display, angleX, angleY);
-        angleX += 0.05f;
-        angleY += 0.03f;
+        // angles follow elapsed time so the spin speed does not depend on the frame rate
+        float t = (m_ui.getCurrentTime() - m_enterTime) / 1000.0f;
+        drawCube(display, t * 3.0f, t * 1.8f);
     }
 
+    // the cube never settles, so ask for a steady redraw instead of invalidating from draw()
+    uint16_t getFrameRate() const override { return 30; }
+
     bool handleInput(InputEvent event) override {
         if (event == InputEvent::BACK) {
             requestExit();
@@ -129,12 +131,11 @@ public:
     
     void onEnter(ExitCallback cb) override {
         IApplication::onEnter(cb);
-        m_ui.setContinousDraw(true);
+        m_enterTime = m_ui.getCurrentTime();
         m_ui.markDirty(); 
     }
 
     void onExit() {
-        m_ui.setContinousDraw(false);
         m_ui.markFading();
     }
 };
@@ -51,16 +51,15 @@ private:
     int32_t rectWidth = 10;           // Background rectangle width
     int batteryPercent = 50;       // Assumed battery level is 50%
 
-    // State machine
+    // State machine, advanced by the timeline hooks
     ChargeState state = ChargeState::LIGHTNING_AND_RING;
-    unsigned long stateEnterTime = 0; // The time when each state is entered
+    Timeline m_timeline;
 
 public:
     ChargeDemo(PixelUI& ui) : m_ui(ui) {}
 
     // ---------------- Drawing function ----------------
     void draw() override {
-        m_ui.markDirty();
         U8G2& display = m_ui.getU8G2();
 
         int centerX = 64 + lightningOffsetX;
@@ -79,54 +78,12 @@ public:
             display.setFont(u8g2_font_6x10_tf);
             display.drawStr(65, 36, buf);
         }
-
-        // State machine scheduler
-        updateState();
     }
 
-    // ---------------- State machine scheduler ----------------
-    void updateState() {
-        switch(state) {
-            case ChargeState::LIGHTNING_AND_RING:
-                // Transition to the next state only after the initial animation is mostly complete.
-                // 仅在初始动画基本完成后，才过渡到下一个状态。
-                if (m_ui.getCurrentTime() - stateEnterTime > 1200) {
-                    state = ChargeState::SHRINK_RING;
-                    stateEnterTime = m_ui.getCurrentTime();
-                    // Animate the ring shrinking to 0
-                    // 动画圆环收缩到0
-                    m_ui.animate(ringPercent, 0, 600, EasingType::EASE_OUT_CUBIC);
-                }
-                break;
-
-            case ChargeState::SHRINK_RING:
-                // Check if the ring animation is complete (ringPercent is close to 0).
-                // 检查圆环动画是否完成（ringPercent接近0）。
-                if (m_ui.getCurrentTime() - stateEnterTime > 900) {
-                    state = ChargeState::MOVE_LIGHTNING;
-                    stateEnterTime = m_ui.getCurrentTime();
-                    // Animate lightning moving left, percentage text appearing, and background expanding
-                    // 动画闪电左移，百分比文字出现，背景板展开
-                    
-                    m_ui.animate(lightningOffsetX, -10, 600, EasingType::EASE_OUT_CUBIC);
-                    m_ui.animate(batteryPercent_anim, batteryPercent, 600, EasingType::EASE_OUT_CUBIC);
-                    m_ui.animate(rectWidth, 90, 670, EasingType::EASE_OUT_CUBIC);
-                }
-                break;
-
-            case ChargeState::MOVE_LIGHTNING:
-                // Transition to DONE after the move animation is complete
-                // 在移动动画完成后，过渡到DONE状态
-                if (m_ui.getCurrentTime() - stateEnterTime > 2200) {
-                    state = ChargeState::DONE;
-                    stateEnterTime = m_ui.getCurrentTime();
-                }
-                break;
-
-            case ChargeState::DONE:
-                // Remain in the final state
-                requestExit();
-                break;
+    // Leave once the whole sequence has played
+    void update(uint32_t /*currentTime*/) override {
+        if (state == ChargeState::DONE) {
+            requestExit();
         }
     }
 
@@ -140,25 +97,32 @@ public:
     void onEnter(ExitCallback cb) override {
         IApplication::onEnter(cb);
 
-        // Lightning size animation
-        m_ui.animate(lightIconSize, 7, 400, EasingType::EASE_IN_CUBIC, PROTECTION::PROTECTED);
-
-        // Ring animates from 0 to the battery percentage
         ringPercent = 0;
-        m_ui.animate(ringPercent, batteryPercent, 600, EasingType::EASE_OUT_CUBIC);
-
         batteryPercent_anim = 0; // Percentage text is hidden initially
         lightningOffsetX = 0;    // Initial lightning position
-
         state = ChargeState::LIGHTNING_AND_RING;
-        stateEnterTime = m_ui.getCurrentTime();
 
-        m_ui.setContinousDraw(true);
+        m_timeline.clear()
+            // Lightning appears, ring fills from 0 to the battery percentage
+            .add(lightIconSize, 7, 400, EasingType::EASE_IN_CUBIC)
+            .add(ringPercent, batteryPercent, 600, EasingType::EASE_OUT_CUBIC)
+            .then(600)
+            // Ring shrinks to 0
+            .call([this]() { state = ChargeState::SHRINK_RING; })
+            .add(ringPercent, 0, 600, EasingType::EASE_OUT_CUBIC)
+            .then(300)
+            // Lightning moves left, percentage text appears, background expands
+            .call([this]() { state = ChargeState::MOVE_LIGHTNING; })
+            .add(lightningOffsetX, -10, 600, EasingType::EASE_OUT_CUBIC)
+            .add(batteryPercent_anim, batteryPercent, 600, EasingType::EASE_OUT_CUBIC)
+            .add(rectWidth, 90, 670, EasingType::EASE_OUT_CUBIC)
+            .then(1530)
+            .onComplete([this]() { state = ChargeState::DONE; });
+        m_ui.playTimeline(m_timeline);
         m_ui.markDirty();
     }
 
     void onExit() override {
-        m_ui.setContinousDraw(false);
         m_ui.markFading();
     }
 
@@ -20,7 +20,11 @@
 #include "U8g2lib.h"
 #include "core/animation/animation.h"
 #include "ui/IDrawable.h"
+#include "core/transition/transition.h"
+#include "core/text/text_metrics.h"
+#include "core/text/glyph_cache.h"
 #include "core/CommonTypes.h"
+#include <atomic>
 
 /**
  * @class IInputHandler
@@ -34,6 +38,9 @@ public:
 
 using InputCallback = std::function<bool(InputEvent)>;
 
+// Starts transmitting a finished frame and returns right away, see PixelUI::setAsyncFlushCallback().
+using AsyncFlushCallback = std::function<void(const uint8_t* buffer, uint8_t tileWidth, uint8_t tileHeight)>;
+
 typedef void (*DelayFunction)(uint32_t);
 
 class ViewManager;
@@ -62,6 +69,31 @@ public:
      * @param ms Time elapsed since the last call.
      */
     void Heartbeat(uint32_t ms);
+
+    /**
+     * @brief Frame-paced main loop step, an alternative to calling Heartbeat() and renderer() separately.
+     * @param now Monotonic time in milliseconds.
+     * @return True if a frame was rendered.
+     */
+    bool runFrame(uint32_t now);
+
+    /**
+     * @brief Configures the fixed logic step of runFrame().
+     * @param tickMs Length of one logic tick in milliseconds.
+     * @param maxCatchUpTicks Most ticks run by one runFrame() call after a stall.
+     */
+    void setFramePacing(uint32_t tickMs, uint8_t maxCatchUpTicks) { if (tickMs) tickMs_ = tickMs; if (maxCatchUpTicks) maxCatchUpTicks_ = maxCatchUpTicks; }
+
+    /**
+     * @brief Selects how frames are transferred to the display.
+     *
+     * FlushMode::TILE_DIFF keeps a copy of the last transmitted frame and sends only the
+     * 8x8 tiles that changed since, which pays off on slow buses such as I2C. The copy
+     * costs one extra frame buffer of RAM and is released again with FlushMode::FULL.
+     * @param mode The new flush mode; the next frame is always sent in full.
+     */
+    void setFlushMode(FlushMode mode);
+    FlushMode getFlushMode() const { return flushMode_; }
     
     // animation related functions.
     
@@ -72,8 +104,9 @@ public:
      * @param duration Duration of the animation.
      * @param easing Easing function to use.
      * @param prot Protection status.
+     * @return Handle of the pooled tween driving the value.
      */
-    void animate(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing = EasingType::LINEAR, PROTECTION prot = PROTECTION::NOT_PROTECTED);
+    AnimationHandle animate(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing = EasingType::LINEAR, PROTECTION prot = PROTECTION::NOT_PROTECTED);
     
     /**
      * @brief Creates and starts a two-value animation.
@@ -86,18 +119,73 @@ public:
      * @param prot Protection status.
      */
     void animate(int32_t& x, int32_t& y, int32_t targetX, int32_t targetY, uint32_t duration, EasingType easing = EasingType::LINEAR, PROTECTION prot = PROTECTION::NOT_PROTECTED);
+
+    /**
+     * @brief Starts or retargets a multi-lane animation, one easing evaluation for all lanes.
+     * @param animation The animation, it must stay alive while running.
+     * @param targetValues The final value of each lane.
+     * @param duration Duration of the animation.
+     * @param easing Easing function to use.
+     * @param prot Protection status.
+     */
+    template <size_t N>
+    void animate(VecAnimation<N>& animation, const int32_t (&targetValues)[N], uint32_t duration, EasingType easing = EasingType::LINEAR, PROTECTION prot = PROTECTION::NOT_PROTECTED) {
+        m_animationManagerPtr->animate(animation, targetValues, duration, easing, _currentTime, prot);
+    }
+
+    /**
+     * @brief Pulls a value towards a target with a critically damped spring.
+     * Calling it again on the same value retargets the spring and keeps its velocity.
+     * @param value Reference to the value to animate.
+     * @param targetValue The value to settle at.
+     * @param settleTime Time the spring takes to settle from rest.
+     * @param prot Protection status.
+     * @return Handle of the pooled spring, it stops running once the value is at rest.
+     */
+    AnimationHandle spring(int32_t& value, int32_t targetValue, uint32_t settleTime, PROTECTION prot = PROTECTION::NOT_PROTECTED) { return m_animationManagerPtr->spring(value, targetValue, settleTime, _currentTime, prot); }
     
     /**
      * @brief Adds a custom animation to the manager.
      * @param animation The animation to add.
      */
     void addAnimation(std::shared_ptr<Animation> animation);
+
+    /**
+     * @brief Start playing a timeline from the current time.
+     * @param timeline The timeline, it must stay alive while playing.
+     * @param prot Protection status of the timeline and the tweens it starts.
+     */
+    void playTimeline(Timeline& timeline, PROTECTION prot = PROTECTION::NOT_PROTECTED) { m_animationManagerPtr->play(timeline, _currentTime, prot); }
+
+    /**
+     * @brief Stop a timeline and the tweens it has started, its remaining steps are dropped.
+     * @param timeline The timeline to stop.
+     */
+    void stopTimeline(Timeline& timeline) { m_animationManagerPtr->stop(timeline); }
     
     /**
      * @brief Marks an animation as protected, preventing it from being cleared.
      * @param animation The animation to protect.
      */
     void markAnimationProtected(std::shared_ptr<Animation> animation) { m_animationManagerPtr->markProtected(animation); }
+
+    /**
+     * @brief Stops a pooled animation, leaving its value where it is.
+     * @param handle The handle returned by animate().
+     */
+    void stopAnimation(AnimationHandle handle) { m_animationManagerPtr->stop(handle); }
+
+    /**
+     * @brief Stops a multi-lane animation, leaving its values where they are.
+     * @param animation The animation to stop.
+     */
+    void stopAnimation(VecAnimationBase& animation) { m_animationManagerPtr->stop(animation); }
+
+    /**
+     * @brief Checks whether a pooled animation is still running.
+     * @param handle The handle returned by animate().
+     */
+    bool isAnimationRunning(AnimationHandle handle) const { return m_animationManagerPtr->isRunning(handle); }
     
     /**
      * @brief Clears all unprotected animations.
@@ -114,15 +202,40 @@ public:
      */
     void clearAllAnimations() { m_animationManagerPtr->clear(); }
 
+    /**
+     * @brief Stops every animation started by an owner, protected or not.
+     * @param scope The owner, usually `this` of a view, widget or popup.
+     */
+    void cancelAnimations(AnimationScope scope) { m_animationManagerPtr->cancel(scope); }
+
     uint32_t getCurrentTime() const { return _currentTime; }
 
     // setters
-    void setDrawable(std::shared_ptr<IDrawable> drawable) { currentDrawable_ = drawable; }
+    void setDrawable(std::shared_ptr<IDrawable> drawable) { currentDrawable_ = drawable; fullRedraw_ = true; }
     void setRefreshCallback(std::function <void()> function) { if (function) m_refresh_callback = function; }
     void setInputCallback(InputCallback callback) { if(callback) inputCallback_ = callback; }
-    void setContinousDraw(bool isEnabled) { continousMode_ = isEnabled; };
     void setDelayFunction(DelayFunction func) {if (func) m_func_delay = func; }
     void setDebugPrintFunction(void (*func)(const char*)) { if (func) m_func_debug_print = func; }
+    void setDisplayBusyCallback(std::function<bool()> callback) { m_displayBusyCallback = callback; }
+
+    /**
+     * @brief Hands finished frames to an asynchronous transmitter instead of sendBuffer().
+     *
+     * Each frame is copied into a second frame buffer that the callback transmits from,
+     * e.g. with DMA or on a worker thread, while the next frame is drawn into the u8g2
+     * buffer. notifyFlushComplete() must be called once the transfer is done; until then
+     * no new frame is rendered, so the second buffer is never written while it is sent.
+     * Frames are always sent whole, setFlushMode() only applies to synchronous flushing.
+     * @param callback The transmitter, nullptr to go back to sendBuffer() and release the buffer.
+     */
+    void setAsyncFlushCallback(AsyncFlushCallback callback);
+
+    /**
+     * @brief Signals that the frame passed to the async flush callback was transmitted.
+     * Safe to call from an interrupt handler or another thread.
+     */
+    void notifyFlushComplete() { flushBusy_ = false; }
+    bool isFlushBusy() const { return flushBusy_; }
 
     #ifdef USE_DEBUG_OUPUT
         void debugPrint(const char* msg);
@@ -133,12 +246,39 @@ public:
     std::shared_ptr<AnimationManager> getAnimationManPtr() { return m_animationManagerPtr; }
     std::shared_ptr<PopupManager> getPopupManagerPtr() { return m_popupManagerPtr; }
 
+    /**
+     * @brief Cached text measuring for the current font, use it instead of U8G2::getStrWidth()
+     * and U8G2::getUTF8Width() in code that runs every frame or on every input.
+     */
+    TextMetrics& getTextMetrics() { return textMetrics_; }
+
+    /**
+     * @brief Text drawing through the optional decoded glyph cache, see GlyphCache::setBudget().
+     * Draws exactly like U8G2::drawStr() and U8G2::drawUTF8(), with or without the cache.
+     */
+    GlyphCache& getGlyphCache() { return glyphCache_; }
+
     bool isDirty() const { return isDirty_; }
-    bool isFading() const { return isFading_; }
+    bool isFading() const { return transition_.isActive(); }
     bool isPointerValid(const void* ptr) const { return ptr != nullptr; }
 
-    bool isContinousRefreshEnabled() const { return continousMode_; }
     uint32_t getActiveAnimationCount() const { return m_animationManagerPtr->activeCount(); }
+    const FrameStats& getFrameStats() const { return frameStats_; }
+
+    /**
+     * @brief True when the display uses a u8g2 page buffer (the _1 and _2 constructors).
+     * renderer() then replays the draw pass once per page. Tile-diff and async flushing
+     * need a full frame buffer and are not available; transitions start from a blank screen.
+     */
+    bool isPageBufferMode() const;
+
+    /**
+     * @brief Whether anything drawn inside the area can reach the buffer right now.
+     * False when it lies outside the current page or the clip window, or entirely under
+     * a popup, so a drawable can skip work that would be discarded or painted over.
+     * Drawables run once per page in page buffer mode.
+     */
+    bool isAreaVisible(int32_t x, int32_t y, int32_t w, int32_t h) const;
 
     std::shared_ptr<IDrawable> getDrawable() const { return currentDrawable_; }
 
@@ -172,17 +312,41 @@ public:
 
     /**
      * @brief Marks the display buffer as dirty, forcing a redraw.
+     *
+     * Frames are only rendered when something invalidated the screen: an animated value
+     * changed, input was handled, a popup opened or closed, or markDirty() was called.
      */
     void markDirty() { isDirty_ = true; }
+
+    /**
+     * @brief Invalidates the screen once ms milliseconds of UI time have passed.
+     * For state that changes with time but not through an animation, e.g. a timeout.
+     * The earliest pending request wins.
+     * @param ms Delay in milliseconds.
+     */
+    void invalidateAfter(uint32_t ms);
     
     /**
-     * @brief Marks the UI as fading out.
+     * @brief Marks the UI as fading out, a dither fade from the current screen to the next.
+     */
+    void markFading() { startTransition(TransitionType::DITHER_FADE); }
+
+    /**
+     * @brief Starts a transition from the screen currently shown to whatever is rendered next.
+     *
+     * The effect advances with every rendered frame while Heartbeat() keeps running, so
+     * input and animations are not held up by it.
+     * @param type The effect to play.
+     * @param duration Length in milliseconds, 0 for the default of the effect.
      */
-    void markFading() { isFading_ = true; }
+    void startTransition(TransitionType type, uint32_t duration = 0);
 
     bool handleInput(InputEvent event) {
-        if (inputCallback_) return inputCallback_(event);
-        return false;
+        if (!inputCallback_) return false;
+        // handled input almost always changes what is shown
+        bool handled = inputCallback_(event);
+        if (handled) markDirty();
+        return handled;
     }
     
     /**
@@ -202,10 +366,46 @@ private:
     std::shared_ptr<IDrawable> currentDrawable_;
 
     bool isDirty_ = false;
-    bool isFading_ = false;
-    bool continousMode_ = false;
+    Transition transition_;
+    TextMetrics textMetrics_;
+    GlyphCache glyphCache_;
+    uint32_t lastPacedFrameTime_ = 0; // last frame requested by the drawable's getFrameRate()
+    uint32_t wakeTime_ = 0;           // see invalidateAfter()
+    bool wakePending_ = false;
+    bool fullRedraw_ = true; // next frame ignores drawable damage, see renderDamage()
+    bool popupsOnScreen_ = false;
+    FocusBox occluded_ = {0, 0, 0, 0}; // hidden under popups while the drawable draws
+    bool occlusionActive_ = false;
+
+    // tile diff flushing, see setFlushMode()
+    FlushMode flushMode_ = FlushMode::FULL;
+    std::unique_ptr<uint8_t[]> lastFlushed_;
+    bool lastFlushedValid_ = false;
+
+    // double buffering, see setAsyncFlushCallback()
+    AsyncFlushCallback m_asyncFlushCallback = nullptr;
+    std::unique_ptr<uint8_t[]> flushingBuffer_;
+    std::atomic<bool> flushBusy_{false};
+
+    // frame pacing, see runFrame()
+    uint32_t tickMs_ = FRAME_TICK_MS;
+    uint8_t maxCatchUpTicks_ = MAX_CATCHUP_TICKS;
+    bool framePacingStarted_ = false;
+    uint32_t lastFrameTime_ = 0;
+    uint32_t tickBacklog_ = 0;
+    uint32_t statsWindowStart_ = 0;
+    uint32_t windowTicks_ = 0;
+    uint32_t windowFrames_ = 0;
+    uint32_t windowTiles_ = 0;
+    FrameStats frameStats_;
+
+    bool renderDamage(DamageList& damage);
+    void renderPages();
+    void drawDrawable();
+    void flushBuffer();
 
     std::function<void()> m_refresh_callback = nullptr;
+    std::function<bool()> m_displayBusyCallback = nullptr;
     DelayFunction m_func_delay = nullptr;
     InputCallback inputCallback_ = nullptr;
     
@@ -19,7 +19,42 @@
 
 // Maximum of concurrent animation going on.
 constexpr int MAX_ANIMATION_COUNT = 25; 
+// Maximum of concurrent custom (Animation subclass) animations. They no longer share the
+// MAX_ANIMATION_COUNT slots with tweens, so this is the whole limit for addAnimation(),
+// which drops an animation once it is reached.
+constexpr int MAX_CUSTOM_ANIMATION_COUNT = 8;
+// Maximum of concurrent spring animations.
+constexpr int MAX_SPRING_COUNT = 12;
+// Maximum of concurrently running multi-lane (VecAnimation) tweens.
+constexpr int MAX_VEC_ANIMATION_COUNT = 4;
+// Maximum of pooled tweens parked while their owner scope is suspended.
+constexpr int MAX_SUSPENDED_ANIMATION_COUNT = 16;
+// Maximum of concurrently playing timelines, and of steps in a single timeline.
+constexpr int MAX_TIMELINE_COUNT = 4;
+constexpr int MAX_TIMELINE_STEPS = 12;
 constexpr int MAX_TEXT_LENGTH = 30;
+// Fixed logic step of PixelUI::runFrame() (milliseconds), and the most steps it catches up after a stall.
+constexpr int FRAME_TICK_MS = 16;
+constexpr int MAX_CATCHUP_TICKS = 4;
+// Maximum of damaged rectangles a drawable can report for a partial redraw.
+constexpr int MAX_DAMAGE_RECTS = 4;
+// Default durations (milliseconds) of the screen transitions.
+constexpr int TRANSITION_FADE_MS = 160;
+constexpr int TRANSITION_SLIDE_MS = 250;
+constexpr int TRANSITION_WIPE_MS = 200;
+// Fonts whose glyph metrics TextMetrics keeps at once, non-ASCII glyphs kept per font,
+// and widths of static strings remembered. A font's table (about 490 bytes on 32 bit
+// targets with the defaults) is allocated when the font is first measured, so measuring
+// text can allocate until TEXT_METRICS_FONT_NUM fonts were seen since start or clear();
+// later fonts take over the least recently used table in place. A static width costs
+// 12 bytes.
+constexpr int TEXT_METRICS_FONT_NUM = 4;
+constexpr int TEXT_METRICS_OTHER_GLYPHS = 16;
+constexpr int TEXT_METRICS_STATIC_NUM = 16;
+// Maximum of lines a TextLayout wraps a text into.
+constexpr int MAX_TEXT_LAYOUT_LINES = 8;
+// Hash buckets of the glyph cache, its RAM budget is set at runtime with GlyphCache::setBudget().
+constexpr int GLYPH_CACHE_BUCKETS = 32;
 
 // Maximum item that can be iterated during initialization.
 constexpr int MAX_APP_NUM = 10;
@@ -29,6 +64,9 @@ constexpr int MAX_LISTVIEW_SLOT_NUM = 30;
 constexpr int MAX_LISTITEM_NAME_NUM = 30;
 constexpr int LISTVIEW_ITEMS_PER_PAGE = 6;
 constexpr int MAX_LISTVIEW_DEPTH = 6;
+// A selected ListView title too long for its row scrolls at this speed, pausing at either end.
+constexpr int LISTVIEW_MARQUEE_SPEED = 24; // pixels per second
+constexpr int LISTVIEW_MARQUEE_PAUSE_MS = 1000;
 
 constexpr int CALLBACK_ANIMATION_STACK_SIZE = 2;
 constexpr int MAX_POPUP_NUM = 3;
@@ -49,6 +49,30 @@ enum class PROTECTION {
     PROTECTED
 };
 
+// Effects for switching between screens, see PixelUI::startTransition().
+enum class TransitionType {
+    DITHER_FADE, // checkerboard dissolve
+    SLIDE_LEFT,  // new screen pushes the old one out to the left
+    SLIDE_RIGHT, // new screen pushes the old one out to the right
+    WIPE         // new screen is revealed from the left edge
+};
+
+// How a finished frame is transferred to the display, see PixelUI::setFlushMode().
+enum class FlushMode {
+    FULL,      // sendBuffer() every frame
+    TILE_DIFF  // only the 8x8 tiles that differ from the last transmitted frame
+};
+
+// Achieved rates of the frame-paced loop, see PixelUI::runFrame().
+struct FrameStats {
+    uint32_t tickRate = 0;      // logic ticks per second, over the last second
+    uint32_t frameRate = 0;     // rendered frames per second, over the last second
+    uint32_t droppedFrames = 0; // ticks whose frame was skipped because the display was still busy
+    uint32_t droppedTicks = 0;  // ticks skipped after stalls longer than the catch-up limit
+    uint32_t tilesPerFrame = 0; // 8x8 display tiles transmitted per rendered frame, over the last second
+    uint32_t tilesSent = 0;     // 8x8 display tiles transmitted in total
+};
+
 struct FocusBox {
     int32_t x;
     int32_t y;
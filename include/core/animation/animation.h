@@ -21,6 +21,7 @@
 #include <memory>
 #include "etl/vector.h"
 #include <functional>
+#include <type_traits>
 #include "config.h"
 #include "core/CommonTypes.h"
 #include "core/animation/animation.h"
@@ -31,9 +32,21 @@
 #define FIXED_POINT_ONE (1 << SHIFT_BITS)
 #define FLOAT_TO_FIXED(f) ((int32_t)((f) * FIXED_POINT_ONE))
 
+// Number of entries (minus one) of each easing lookup table, see USE_EASING_LUT.
+// Must be a power of two no larger than FIXED_POINT_ONE.
+#define EASING_LUT_BITS 8
+#define EASING_LUT_SIZE (1 << EASING_LUT_BITS)
+
+constexpr int EASING_TYPE_COUNT = static_cast<int>(EasingType::EASE_OUT_BOUNCE) + 1;
+
 /**
  * @class EasingCalculator
  * @brief Calculate easing progress based on easing type and normalized time.
+ *
+ * Two kernels are provided: the exact fixed-point math, and lookup tables
+ * sampled from it at compile time and linearly interpolated at runtime.
+ * calculate() uses the tables when USE_EASING_LUT is defined, which trades
+ * ~3.5 KB of flash for no 64-bit multiplies or divisions per evaluation.
  */
 class EasingCalculator {
 public:
@@ -44,12 +57,89 @@ public:
      */
     static int32_t calculate(EasingType type, int32_t t);
 
+    /**
+     * @brief calculate progress using the exact fixed-point math.
+     * @param type easing type.
+     * @param t normalized time, fixed-point.
+     */
+    static constexpr int32_t calculateExact(EasingType type, int32_t t) {
+        switch (type) 
+        {
+            case EasingType::LINEAR:            return t;
+            case EasingType::EASE_IN_QUAD:      return mulFixed(t, t);
+            case EasingType::EASE_OUT_QUAD:     
+            {
+                int32_t inverse_t = FIXED_POINT_ONE - t;
+                return FIXED_POINT_ONE - mulFixed(inverse_t, inverse_t);
+            }
+            case EasingType::EASE_IN_OUT_QUAD:  
+                if (t < (FIXED_POINT_ONE / 2)) {
+                    return mulFixed(2 * t, t);
+                } else {
+                    int32_t val = (FIXED_POINT_ONE * 2) - (2 * t);
+                    return FIXED_POINT_ONE - mulFixed(val, val) / 2;
+                }
+            case EasingType::EASE_IN_CUBIC:     return mulFixed(mulFixed(t, t), t);
+            case EasingType::EASE_OUT_CUBIC:    
+            {
+                int32_t inverse_t = FIXED_POINT_ONE - t;
+                return FIXED_POINT_ONE - mulFixed(mulFixed(inverse_t, inverse_t), inverse_t);
+            }
+            case EasingType::EASE_IN_OUT_CUBIC: 
+                if (t < (FIXED_POINT_ONE / 2)) {
+                    return mulFixed(4 * t, mulFixed(t, t));
+                } else {
+                    int32_t val = (FIXED_POINT_ONE * 2) - (2 * t);
+                    return FIXED_POINT_ONE - mulFixed(mulFixed(val, val), val) / 2;
+                }
+            case EasingType::EASE_OUT_BOUNCE:   return easeOutBounce(t);
+            default:                            return t;
+        }
+    }
+
+    /**
+     * @brief calculate progress from the compile-time lookup tables.
+     * @param type easing type.
+     * @param t normalized time, fixed-point.
+     */
+    static int32_t calculateLut(EasingType type, int32_t t);
+
 private:
+    // Convert float multiplication to integer multiplication and bit shift
+    static constexpr int64_t mulFixed(int64_t a, int64_t b) { return a * b >> SHIFT_BITS; }
+
     /**
      * @brief ease out bounce function.
      * @param t normalized time, fixed-point.
      */
-    static int32_t easeOutBounce(int32_t t);
+    static constexpr int32_t easeOutBounce(int32_t t) {
+        // fixed-point division and multiplication, truncating towards zero
+        auto fixedDiv = [](int64_t a, int64_t b) -> int64_t { return a * FIXED_POINT_ONE / b; };
+        auto fixedMul = [](int64_t a, int64_t b) -> int64_t { return a * b / FIXED_POINT_ONE; };
+
+        const int32_t n1 = FLOAT_TO_FIXED(7.5625f);
+        const int32_t d1 = FLOAT_TO_FIXED(2.75f);
+        
+        if (t < fixedDiv(FIXED_POINT_ONE, d1)) 
+        {
+            return fixedMul(n1, fixedMul(t, t));
+        } 
+        else if (t < fixedDiv(FLOAT_TO_FIXED(2.0f), d1))
+        {
+            t -= fixedDiv(FLOAT_TO_FIXED(1.5f), d1);
+            return fixedMul(n1, fixedMul(t, t)) + FLOAT_TO_FIXED(0.75f);
+        }
+        else if (t < fixedDiv(FLOAT_TO_FIXED(2.5f), d1))
+        {
+            t -= fixedDiv(FLOAT_TO_FIXED(2.25f), d1);
+            return fixedMul(n1, fixedMul(t, t)) + FLOAT_TO_FIXED(0.9375f);
+        }
+        else 
+        {
+            t -= fixedDiv(FLOAT_TO_FIXED(2.625f), d1);
+            return fixedMul(n1, fixedMul(t, t)) + FLOAT_TO_FIXED(0.984375f);
+        }
+    }
 };
 
 /**
@@ -83,25 +173,306 @@ private:
     uint32_t _duration;
 };
 
+/**
+ * @struct AnimationHandle
+ * @brief Lightweight reference to a tween living in the AnimationManager pool.
+ *
+ * A handle stays safe to use after its tween has finished or been cleared;
+ * the manager simply no longer recognises it.
+ */
+struct AnimationHandle {
+    uint16_t id = 0;
+
+    bool isValid() const { return id != 0; }
+};
+
+/**
+ * @brief Owner tag of animations, the address of the view, widget or popup that started them.
+ *
+ * The AnimationManager tags every animation with the scope current at the time
+ * it is started; nullptr is the global scope.
+ */
+using AnimationScope = const void*;
+
+class AnimationManager;
+
+/**
+ * @class VecAnimationBase
+ * @brief Size-independent part of a VecAnimation, played by the AnimationManager.
+ */
+class VecAnimationBase {
+public:
+    VecAnimationBase(const VecAnimationBase&) = delete;
+    VecAnimationBase& operator=(const VecAnimationBase&) = delete;
+
+    bool isRunning() const { return _manager != nullptr; }
+
+protected:
+    struct Lane {
+        int32_t* value = nullptr;
+        int32_t startVal = 0;
+        int32_t endVal = 0;
+        int32_t current = 0;              // last value written to the lane
+        int32_t velocity = 0;             // carried over from a retarget, fixed-point units per ms
+    };
+
+    VecAnimationBase(Lane* lanes, uint8_t laneCount) : _lanes(lanes), _laneCount(laneCount) {}
+    ~VecAnimationBase();
+
+private:
+    friend class AnimationManager;
+
+    Lane* _lanes;
+    uint8_t _laneCount;
+    EasingType _easing = EasingType::LINEAR;
+    uint32_t _startTime = 0;
+    uint32_t _duration = 0;
+    uint32_t _invDuration = 0;
+    uint32_t _suspendedAt = 0;
+    bool _suspended = false;
+    AnimationScope _owner = nullptr;
+    PROTECTION _prot = PROTECTION::NOT_PROTECTED;
+    AnimationManager* _manager = nullptr; // set while running
+};
+
+/**
+ * @class VecAnimation
+ * @brief A tween driving N values along one shared curve.
+ *
+ * The lanes (say x/y/w/h of a box) share start time, duration and easing,
+ * so the easing is evaluated once per update and the tween takes a single
+ * manager slot instead of N. The animation is owned by the caller and must
+ * outlive its run; values it drives should not be animated separately while
+ * it runs.
+ */
+template <size_t N>
+class VecAnimation : public VecAnimationBase {
+public:
+    template <typename... Values>
+    explicit VecAnimation(Values&... values) : VecAnimationBase(_storage, N), _storage{Lane{&values}...} {
+        static_assert(sizeof...(Values) == N, "VecAnimation needs exactly one value per lane");
+        static_assert((std::is_same_v<Values, int32_t> && ...), "VecAnimation lanes must be int32_t");
+    }
+
+private:
+    Lane _storage[N];
+};
+
+/**
+ * @class Timeline
+ * @brief A preallocated schedule of tweens and hooks, played by the AnimationManager.
+ *
+ * Steps added between two then() calls form a group that starts together,
+ * each step optionally delayed; then() starts the next group once the
+ * longest step of the current one has finished. The manager starts due
+ * steps once per update, so apps build a timeline once and play it instead
+ * of polling the time in draw().
+ *
+ * A timeline holds up to MAX_TIMELINE_STEPS steps and allocates nothing
+ * after construction, as long as hooks only capture a pointer or two.
+ * Tweens start from whatever value they hold when their step comes due.
+ */
+class Timeline {
+public:
+    Timeline() = default;
+    ~Timeline();
+
+    Timeline(const Timeline&) = delete;
+    Timeline& operator=(const Timeline&) = delete;
+
+    Timeline& clear();
+    Timeline& add(int32_t& value, int32_t targetValue, uint32_t duration,
+                  EasingType easing = EasingType::LINEAR, uint32_t delay = 0);
+    Timeline& call(std::function<void()> hook, uint32_t delay = 0);
+    Timeline& then(uint32_t gap = 0);
+    Timeline& onComplete(std::function<void()> hook);
+
+    bool isPlaying() const { return _manager != nullptr; }
+    uint32_t getDuration() const { return _duration; }
+
+private:
+    friend class AnimationManager;
+
+    struct Step {
+        int32_t* value = nullptr;         // tween target, nullptr for hooks
+        int32_t targetValue = 0;
+        uint32_t offset = 0;              // start, milliseconds after the timeline started
+        uint32_t duration = 0;
+        EasingType easing = EasingType::LINEAR;
+        std::function<void()> hook;
+        AnimationHandle tween;            // set once the tween has started
+    };
+
+    Step* appendStep(uint32_t offset, uint32_t duration);
+
+    Step _steps[MAX_TIMELINE_STEPS];
+    uint8_t _stepCount = 0;
+    uint32_t _started = 0;                // bit i is set once step i has started
+    uint32_t _groupStart = 0;
+    uint32_t _groupEnd = 0;
+    uint32_t _duration = 0;
+    uint32_t _startTime = 0;
+    uint32_t _suspendedAt = 0;
+    bool _suspended = false;
+    AnimationScope _owner = nullptr;
+    PROTECTION _prot = PROTECTION::NOT_PROTECTED;
+    std::function<void()> _onComplete;
+    AnimationManager* _manager = nullptr; // set while playing
+};
+
 /**
  * @class AnimationManager
  * @brief Manages multiple animations, updating and cleaning them up.
+ *
+ * Plain value tweens live in a fixed pool of MAX_ANIMATION_COUNT slots and
+ * never touch the heap. Animating a value that already has a running tween
+ * retargets that tween in place, so a burst of inputs costs one slot per
+ * value. Custom Animation subclasses are still accepted through
+ * addAnimation() for effects the pool can not express.
+ *
+ * The pool is a structure of arrays kept grouped by easing type, so update()
+ * runs one branch-free loop per easing curve instead of a virtual call and a
+ * callback per tween.
+ *
+ * Springs are the interruptible alternative to tweens: a critically damped
+ * spring pulls the value towards its target, can be retargeted at any time
+ * without losing its velocity, and leaves the pool as soon as it is at rest.
+ * A value is driven by either a tween or a spring, switching hands over the
+ * current velocity.
+ *
+ * A VecAnimation tweens several values along one curve in a single slot, for
+ * things that move as a unit like a box.
+ *
+ * Every animation belongs to the scope that was current when it started (see
+ * setScope()), so a view's animations can be suspended, resumed or cancelled
+ * without touching anyone else's. Suspended tweens are parked outside the
+ * pool and cost nothing per update.
  */
 class AnimationManager {
 public:
-    ~AnimationManager() = default;
+    ~AnimationManager();
+
+    // Pooled value tweens
+    AnimationHandle animate(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing,
+                            uint32_t currentTime, PROTECTION prot = PROTECTION::NOT_PROTECTED);
+    void stop(AnimationHandle handle);
+    bool isRunning(AnimationHandle handle) const;
+
+    // Multi-lane tweens
+    void animate(VecAnimationBase& animation, const int32_t* targetValues, uint32_t duration, EasingType easing,
+                 uint32_t currentTime, PROTECTION prot = PROTECTION::NOT_PROTECTED);
+    void stop(VecAnimationBase& animation);
+
+    // Pooled springs
+    AnimationHandle spring(int32_t& value, int32_t targetValue, uint32_t settleTime, uint32_t currentTime,
+                           PROTECTION prot = PROTECTION::NOT_PROTECTED);
+
+    // Custom animations
     void addAnimation(std::shared_ptr<Animation> animation);
-    void update(uint32_t currentTime);
+
+    // Timelines
+    void play(Timeline& timeline, uint32_t currentTime, PROTECTION prot = PROTECTION::NOT_PROTECTED);
+    void stop(Timeline& timeline);
+
+    // Owner scopes
+    AnimationScope setScope(AnimationScope scope);
+    AnimationScope getScope() const { return _scope; }
+    void suspend(AnimationScope scope, uint32_t currentTime);
+    void resume(AnimationScope scope, uint32_t currentTime);
+    void cancel(AnimationScope scope);
+
+    /**
+     * @brief Advance every animation to currentTime.
+     * @return true if any animated value changed, a timeline hook ran or a custom animation is running.
+     */
+    bool update(uint32_t currentTime);
     void clear();
 
     // Protection mechanism
     void markProtected(std::shared_ptr<Animation> animation);
+    void markProtected(AnimationHandle handle);
     void clearUnprotected();
     void clearAllProtectionMarks();
 
     size_t activeCount() const;
 private:
-    etl::vector<std::shared_ptr<Animation>, MAX_ANIMATION_COUNT> _animations;
+    int findTween(AnimationHandle handle) const;
+    int findTweenByTarget(const int32_t* target) const;
+    EasingType easingOf(size_t index) const;
+    size_t insertTween(EasingType easing);
+    void removeTween(size_t index);
+    void moveTween(size_t from, size_t to);
+    void compactTweens(const bool* keep);
+    int64_t tweenOffset(size_t index, uint32_t elapsed) const;
+    int findSpring(AnimationHandle handle) const;
+    int findSpringByTarget(const int32_t* target) const;
+    void removeSpring(size_t index);
+    void updateSprings(uint32_t currentTime);
+    void updateVecAnimations(uint32_t currentTime);
+    uint16_t nextId();
+    void updateTimelines(uint32_t currentTime);
+    int32_t tweenVelocity(size_t index, uint32_t currentTime) const;
+    int findSuspendedTween(AnimationHandle handle) const;
+    void dropSuspendedTween(const int32_t* target);
+    void moveSpring(size_t from, size_t to);
+
+    // Tween pool, one array per field. Tweens eased with type e occupy
+    // [_groupBegin[e], _groupBegin[e + 1]), the pool ends at _groupBegin[EASING_TYPE_COUNT].
+    int32_t* _target[MAX_ANIMATION_COUNT];      // value written on every update
+    int32_t _startVal[MAX_ANIMATION_COUNT];
+    int32_t _endVal[MAX_ANIMATION_COUNT];
+    int32_t _current[MAX_ANIMATION_COUNT];      // last value written to target
+    int32_t _velocity[MAX_ANIMATION_COUNT];     // carried over from a retarget, fixed-point units per ms
+    uint32_t _startTime[MAX_ANIMATION_COUNT];
+    uint32_t _duration[MAX_ANIMATION_COUNT];
+    uint32_t _invDuration[MAX_ANIMATION_COUNT]; // (1 << (SHIFT_BITS + 16)) / duration, 0 for instant tweens
+    bool _protected[MAX_ANIMATION_COUNT];
+    uint16_t _id[MAX_ANIMATION_COUNT];          // matches AnimationHandle::id
+    AnimationScope _owner[MAX_ANIMATION_COUNT];
+    uint8_t _groupBegin[EASING_TYPE_COUNT + 1] = {};
+    uint16_t _nextId = 1;                       // shared by tweens and springs
+
+    // Spring pool, one array per field like the tween pool.
+    int32_t* _springTarget[MAX_SPRING_COUNT];
+    int64_t _springPos[MAX_SPRING_COUNT];       // position, fixed-point
+    int32_t _springVel[MAX_SPRING_COUNT];       // fixed-point units per ms
+    int32_t _springGoal[MAX_SPRING_COUNT];
+    int32_t _springOmega[MAX_SPRING_COUNT];     // natural frequency, fixed-point per ms
+    int32_t _springCurrent[MAX_SPRING_COUNT];   // last value written to target
+    uint32_t _springTime[MAX_SPRING_COUNT];     // time of the last integration step
+    bool _springProtected[MAX_SPRING_COUNT];
+    uint16_t _springId[MAX_SPRING_COUNT];
+    AnimationScope _springOwner[MAX_SPRING_COUNT];
+    bool _springSuspended[MAX_SPRING_COUNT];
+    size_t _springCount = 0;
+
+    etl::vector<VecAnimationBase*, MAX_VEC_ANIMATION_COUNT> _vecAnimations;
+
+    // Pooled tweens of suspended scopes, parked until their scope resumes.
+    struct SuspendedTween {
+        int32_t* target;
+        int32_t startVal;
+        int32_t endVal;
+        int32_t current;
+        int32_t velocity;
+        uint32_t elapsed;                       // time already run when suspended
+        uint32_t duration;
+        uint32_t invDuration;
+        AnimationScope owner;
+        uint16_t id;
+        EasingType easing;
+        bool prot;
+    };
+    etl::vector<SuspendedTween, MAX_SUSPENDED_ANIMATION_COUNT> _suspendedTweens;
+
+    AnimationScope _scope = nullptr;            // owner of animations started from now on
+    bool _changed = false;                      // set by the current update() when it changed anything visible
+
+    etl::vector<std::shared_ptr<Animation>, MAX_CUSTOM_ANIMATION_COUNT> _animations;
+
+    // Playing timelines; stopped ones are set to nullptr and swept after the next update,
+    // so a hook can stop or play timelines while they are being resolved.
+    etl::vector<Timeline*, MAX_TIMELINE_COUNT> _timelines;
 };
 
 /**
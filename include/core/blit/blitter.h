@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class Blitter
+ * @brief Word-wide operations on a u8g2 full frame buffer.
+ *
+ * u8g2 stores the frame as pages of 8 pixel rows, one byte per column, so a page
+ * aligned rectangle is a run of bytes per page and whole-buffer operations are plain
+ * byte spans. These run 16 bytes at a time with SSE2 on hosts that have it, and a
+ * machine word at a time elsewhere, instead of byte by byte.
+ *
+ * Pattern masks alternate per byte: evenMask applies to dst[0], dst[2]..., oddMask to
+ * dst[1], dst[3]... In the rectangle functions x is a column and page a row of 8 pixels.
+ */
+class Blitter {
+public:
+    static void fill(uint8_t* dst, size_t len, uint8_t value);
+    static void copy(uint8_t* dst, const uint8_t* src, size_t len); // overlapping spans are fine
+    static void invert(uint8_t* dst, size_t len);                   // dst ^= 0xFF
+
+    /**
+     * @brief dst &= mask, with the mask alternating per byte.
+     */
+    static void mask(uint8_t* dst, size_t len, uint8_t evenMask, uint8_t oddMask);
+
+    /**
+     * @brief dst = (dst & mask) | (src & ~mask): keeps the masked bits of dst, takes the rest from src.
+     */
+    static void blend(uint8_t* dst, const uint8_t* src, size_t len, uint8_t evenMask, uint8_t oddMask);
+
+    /**
+     * @brief dst |= src & rowMask: sets the pixels of src, restricted to the rows in rowMask.
+     */
+    static void merge(uint8_t* dst, const uint8_t* src, size_t len, uint8_t rowMask = 0xFF);
+
+    // page aligned rectangles in a buffer tileWidth tiles wide
+    static void fillRect(uint8_t* buffer, uint8_t tileWidth, uint16_t x, uint8_t page, uint16_t w, uint8_t pages, uint8_t value);
+    static void invertRect(uint8_t* buffer, uint8_t tileWidth, uint16_t x, uint8_t page, uint16_t w, uint8_t pages);
+    static void copyRect(uint8_t* dst, const uint8_t* src, uint8_t tileWidth, uint16_t x, uint8_t page, uint16_t w, uint8_t pages);
+};
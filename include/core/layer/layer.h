@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "U8g2lib.h"
+
+class PixelUI;
+
+/**
+ * @class Layer
+ * @brief Retained 1bpp surface for static content such as a background bitmap or a title.
+ *
+ * The paint function runs once, into a cache kept in the u8g2 tile format (pages of
+ * 8 rows, one byte per column), covering only the pages and columns of the layer.
+ * Every later draw() merges the cache into the frame buffer page by page instead of
+ * decoding the bitmap or font again. The pixels the paint function set are set; all
+ * others are left alone, like drawXBM() in transparent mode. The current clip window
+ * is honoured, so a layer can be revealed with setClipWindow() like any drawing.
+ *
+ * The cache is only rebuilt after invalidate(), setBounds() or setPaint(): call
+ * invalidate() whenever something the paint function reads has changed.
+ * Assumes the U8G2_R0 buffer orientation, as the transitions do.
+ */
+class Layer {
+public:
+    using PaintFunction = std::function<void(U8G2& display)>;
+
+    explicit Layer(PixelUI& ui);
+
+    /**
+     * @brief Places the layer; content outside these bounds is not kept.
+     * @param x Left edge in pixels.
+     * @param y Top edge in pixels, need not be page aligned.
+     * @param w Width in pixels.
+     * @param h Height in pixels.
+     */
+    void setBounds(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+    /**
+     * @brief Sets the function that draws the layer content with regular u8g2 calls.
+     */
+    void setPaint(PaintFunction paint);
+
+    /**
+     * @brief Drops the cached content, the next draw() paints it again.
+     */
+    void invalidate() { _validPages = 0; }
+
+    /**
+     * @brief Composites the layer into the frame buffer, painting it first if needed.
+     */
+    void draw();
+
+    bool isValid() const { return _validPages == allPages(); }
+
+private:
+    uint32_t allPages() const { return _pages >= 32 ? UINT32_MAX : (1u << _pages) - 1; }
+    void rasterize(uint8_t* buffer, size_t stride, int first, int last);
+
+    PixelUI& m_ui;
+    PaintFunction _paint;
+    std::unique_ptr<uint8_t[]> _cache; // _pages rows of _w bytes
+    uint16_t _x = 0, _y = 0, _w = 0, _h = 0;
+    uint8_t _firstPage = 0;
+    uint8_t _pages = 0;
+    uint32_t _validPages = 0; // bit n: page _firstPage + n holds painted content
+};
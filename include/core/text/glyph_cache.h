@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "U8g2lib.h"
+#include "config.h"
+
+/**
+ * @class GlyphCache
+ * @brief Optional RAM cache of decoded glyphs, drawing text without the u8g2 RLE decoder.
+ *
+ * A glyph is decoded once into the u8g2 tile format (pages of 8 rows, one byte per
+ * column) and afterwards written into the frame buffer a page byte at a time, with the
+ * same draw color, font mode and clipping as u8g2. The cache is off until a budget is
+ * set; it then owns exactly that many bytes, for glyph bitmaps and their index. When
+ * it runs full it is emptied and refilled with what is drawn next.
+ *
+ * The draw functions behave like their U8G2 namesakes and simply forward to u8g2 while
+ * the cache is off, the font is rotated or the buffer is not in the vertical page
+ * layout of U8G2_R0, so call sites need not care whether it is enabled.
+ */
+class GlyphCache {
+public:
+    struct Stats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t flushes = 0;  // times the cache ran full and was emptied
+        size_t bytesUsed = 0;  // of the budget, bitmaps and index
+    };
+
+    /**
+     * @brief Size and placement of a glyph, as in its u8g2 glyph header.
+     */
+    struct Glyph {
+        int8_t advance = 0;
+        int8_t xOffset = 0;
+        int8_t yOffset = 0;
+        uint8_t width = 0;
+        uint8_t height = 0;
+    };
+
+    explicit GlyphCache(U8G2& u8g2) : m_u8g2(u8g2) {}
+
+    /**
+     * @brief Sets the RAM the cache may use and empties it.
+     * @param bytes The budget in bytes, 0 turns the cache off and releases its memory.
+     */
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return _budget; }
+    bool isEnabled() const { return _budget != 0; }
+
+    /**
+     * @brief Forgets all glyphs, e.g. after font data in RAM was replaced.
+     */
+    void clear();
+
+    const Stats& getStats() const { return _stats; }
+    void resetStats() { _stats.hits = _stats.misses = _stats.flushes = 0; }
+
+    u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* str) { return draw(x, y, str, SIZE_MAX, false); }
+    u8g2_uint_t drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char* str) { return draw(x, y, str, SIZE_MAX, true); }
+
+    /**
+     * @brief Draws the first length bytes of a UTF-8 string, it need not be terminated there.
+     */
+    u8g2_uint_t drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char* str, size_t length) { return draw(x, y, str, length, true); }
+
+    // The decoder and blitter behind the cache, for code that keeps its own glyph bitmaps.
+
+    /**
+     * @brief Reads the header of a glyph of the current font, leaving the decoder at its pixel runs.
+     * @return false if the font has no such glyph; glyph is then all zero.
+     */
+    static bool readGlyph(u8g2_t* u8g2, uint16_t code, Glyph& glyph, u8g2_font_decode_t& decoder);
+
+    /**
+     * @brief Decodes the pixel runs after readGlyph() into the u8g2 tile format. Glyph pixel
+     * (x, y) sets bit (y + rowOffset) % 8 of bitmap[(y + rowOffset) / 8 * stride + x], so
+     * several glyphs can be decoded side by side into one bitmap.
+     */
+    static void decodeGlyph(u8g2_t* u8g2, u8g2_font_decode_t& decoder, const Glyph& glyph,
+                            uint8_t* bitmap, size_t stride, uint8_t rowOffset = 0);
+
+    /**
+     * @brief Whether the buffer has the vertical page layout of U8G2_R0 that drawBitmap() writes.
+     */
+    static bool canDrawBitmap(const u8g2_t* u8g2);
+
+    /**
+     * @brief Writes a bitmap in the u8g2 tile format like u8g2 draws a glyph: set bits take the
+     * draw color and, in solid mode, the others the background color. Only the part inside
+     * the clip window and the current page is touched.
+     * @param height Rows of the bitmap, at most 32.
+     */
+    static void drawBitmap(u8g2_t* u8g2, const uint8_t* bitmap, uint16_t width, uint8_t height,
+                           u8g2_uint_t left, u8g2_uint_t top, bool solid);
+
+private:
+    struct Entry {
+        const uint8_t* font;
+        uint16_t code;
+        int16_t next;      // next entry in the same bucket, -1 ends the chain
+        uint16_t bitmap;   // offset of the pages in the arena
+        Glyph glyph;
+    };
+
+    u8g2_uint_t draw(u8g2_uint_t x, u8g2_uint_t y, const char* str, size_t length, bool utf8);
+    bool canBlit() const;
+    const Entry* find(uint16_t code);
+    const Entry* insert(uint16_t code);
+    void blit(const Entry& entry, u8g2_uint_t x, u8g2_uint_t y);
+    Entry* entries() const { return reinterpret_cast<Entry*>(_arena.get()); }
+    static uint8_t bucketOf(const uint8_t* font, uint16_t code);
+
+    U8G2& m_u8g2;
+    std::unique_ptr<uint8_t[]> _arena; // entries grow from the front, bitmaps from the back
+    size_t _budget = 0;
+    uint16_t _entryCount = 0;
+    size_t _bitmapStart = 0;
+    int16_t _buckets[GLYPH_CACHE_BUCKETS];
+    Stats _stats;
+};
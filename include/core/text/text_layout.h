@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "U8g2lib.h"
+#include "config.h"
+#include "etl/vector.h"
+
+class PixelUI;
+
+/**
+ * @brief One laid out line: a slice of the source text, not NUL terminated.
+ */
+struct TextSpan {
+    const char* start;
+    uint16_t length; // bytes
+    uint16_t width;  // pixels, as getUTF8Width() measures the slice
+};
+
+/**
+ * @class TextLayout
+ * @brief Word wraps UTF-8 text with the glyph metrics of the current font.
+ *
+ * Lines break after the last space that still fits, or inside a word longer than the
+ * line, and at every '\n'. The lines point into the source text, which is neither
+ * copied nor modified, and are drawn with drawSpan(). The layout is kept until the
+ * text pointer, the font or the width changes, so calling layout() every frame is
+ * cheap; call invalidate() if the text behind the same pointer was rewritten.
+ */
+class TextLayout {
+public:
+    explicit TextLayout(PixelUI& ui) : m_ui(ui) {}
+
+    /**
+     * @brief Wraps text to maxWidth pixels in the current font, reusing the last layout if nothing changed.
+     * @param text The UTF-8 text, it must outlive the layout.
+     * @param maxWidth The line width in pixels.
+     * @param maxLines Lines kept at most, text beyond them is dropped.
+     * @return The number of lines.
+     */
+    uint16_t layout(const char* text, uint16_t maxWidth, uint16_t maxLines = MAX_TEXT_LAYOUT_LINES);
+
+    void invalidate() { _text = nullptr; }
+
+    uint16_t getLineCount() const { return _lines.size(); }
+    const TextSpan& getLine(uint16_t index) const { return _lines[index]; }
+
+    /**
+     * @brief Draws a line with the current font, through the glyph cache of the PixelUI.
+     * @return The advance of the drawn glyphs.
+     */
+    u8g2_uint_t drawSpan(u8g2_uint_t x, u8g2_uint_t y, const TextSpan& span);
+
+private:
+    PixelUI& m_ui;
+    etl::vector<TextSpan, MAX_TEXT_LAYOUT_LINES> _lines;
+
+    // what the current lines were laid out for
+    const char* _text = nullptr;
+    const uint8_t* _font = nullptr;
+    uint16_t _maxWidth = 0;
+    uint16_t _maxLines = 0;
+};
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "U8g2lib.h"
+#include "config.h"
+
+/**
+ * @class TextMetrics
+ * @brief Measures text in the current u8g2 font without decoding glyph headers each time.
+ *
+ * u8g2 finds every glyph of a string by walking the compressed font data, on every
+ * getStrWidth() call. TextMetrics keeps, per font, the advance, pixel width and x offset
+ * of the printable ASCII glyphs as they are first measured, plus a small LRU of other
+ * glyphs, and can remember the width of strings that never change. A font's table is
+ * allocated when the font is first measured, up to TEXT_METRICS_FONT_NUM of them. Results are the
+ * same as U8G2::getStrWidth() and U8G2::getUTF8Width() with the font currently set,
+ * except for strings starting with a character missing from the font, for which u8g2
+ * adds whatever x offset the last decoded glyph left behind.
+ */
+class TextMetrics {
+public:
+    struct Glyph {
+        int8_t advance = 0;  // pen movement to the next glyph
+        int8_t xOffset = 0;  // left edge of the pixels relative to the pen
+        uint8_t width = 0;   // width of the pixels
+        uint8_t flags = 0;   // KNOWN, PRESENT
+
+        bool isPresent() const { return flags & PRESENT; }
+    };
+
+    explicit TextMetrics(U8G2& u8g2) : m_u8g2(u8g2) {}
+
+    u8g2_uint_t getStrWidth(const char* str) { return measure(str, SIZE_MAX, false); }
+    u8g2_uint_t getUTF8Width(const char* str) { return measure(str, SIZE_MAX, true); }
+
+    /**
+     * @brief Width of the first length bytes of a UTF-8 string, it need not be terminated there.
+     */
+    u8g2_uint_t getUTF8Width(const char* str, size_t length) { return measure(str, length, true); }
+
+    /**
+     * @brief Bytes of the longest prefix of a UTF-8 string at most maxWidth pixels wide,
+     * measured like getUTF8Width(); drawn with a length, e.g. before an ellipsis.
+     */
+    size_t fitUTF8(const char* str, u8g2_uint_t maxWidth);
+
+    /**
+     * @brief Metrics of one glyph of the current font; a glyph missing from the font is all zero.
+     */
+    Glyph getGlyph(uint16_t code) { return glyph(fontCache(), code); }
+
+    /**
+     * @brief Width of a string that is never modified, e.g. a literal or a registered title.
+     * The result is remembered per string address and font, so the text behind the
+     * pointer must not change while it is in use.
+     */
+    u8g2_uint_t getStaticStrWidth(const char* str) { return measureStatic(str, false); }
+    u8g2_uint_t getStaticUTF8Width(const char* str) { return measureStatic(str, true); }
+
+    /**
+     * @brief Forgets all cached metrics and frees the font tables, e.g. after font data in RAM was replaced.
+     */
+    void clear();
+
+private:
+    static constexpr uint16_t FIRST_ASCII = 0x20;
+    static constexpr uint16_t ASCII_COUNT = 0x7F - FIRST_ASCII;
+    static constexpr uint8_t KNOWN = 1;
+    static constexpr uint8_t PRESENT = 2;
+
+    struct FontCache {
+        const uint8_t* font = nullptr;
+        uint32_t lastUse = 0;
+        Glyph ascii[ASCII_COUNT];
+        uint16_t otherCode[TEXT_METRICS_OTHER_GLYPHS]; // most recently used first
+        Glyph other[TEXT_METRICS_OTHER_GLYPHS];
+        uint8_t otherCount = 0;
+
+        // forgets the glyphs in place, for another font to take the table over
+        void reuse(const uint8_t* newFont) {
+            font = newFont;
+            for (Glyph& g : ascii) g.flags = 0;
+            otherCount = 0;
+        }
+    };
+
+    struct StaticWidth {
+        const char* str = nullptr;
+        const uint8_t* font = nullptr;
+        bool utf8 = false;
+        u8g2_uint_t width = 0;
+    };
+
+    u8g2_uint_t measure(const char* str, size_t length, bool utf8);
+    u8g2_uint_t measureStatic(const char* str, bool utf8);
+    FontCache& fontCache();
+    Glyph glyph(FontCache& cache, uint16_t code);
+    Glyph decode(uint16_t code);
+
+    U8G2& m_u8g2;
+    std::unique_ptr<FontCache> m_fonts[TEXT_METRICS_FONT_NUM]; // allocated on first use
+    FontCache* m_current = nullptr;
+    uint32_t m_useCount = 0;
+    StaticWidth m_static[TEXT_METRICS_STATIC_NUM];
+    uint8_t m_nextStatic = 0;
+};
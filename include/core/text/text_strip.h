@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "U8g2lib.h"
+
+class PixelUI;
+
+/**
+ * @class TextStrip
+ * @brief One line of text rasterized once into a 1bpp strip, for text that moves every frame.
+ *
+ * The strip spans the font's bounding box and may be wider than the display. draw()
+ * writes only the columns inside the clip window, so scrolling text through a narrow
+ * window (a marquee) costs a shifted copy of the visible columns per frame instead of
+ * decoding every glyph again. The strip is rebuilt when the text, its content or the
+ * font changes. Rotated fonts, fonts taller than 32 rows and buffers not in the U8G2_R0
+ * page layout are drawn with u8g2 directly.
+ */
+class TextStrip {
+public:
+    explicit TextStrip(PixelUI& ui) : m_ui(ui) {}
+
+    /**
+     * @brief Rasterizes a UTF-8 string in the current font, unless the strip already holds it.
+     * @param text The text, it must stay valid while the strip is drawn.
+     * @return The width of the text in pixels.
+     */
+    uint16_t setText(const char* text);
+
+    uint16_t getWidth() const { return _textWidth; }
+
+    /**
+     * @brief Draws the text like drawUTF8(x, y, text), clipped to the clip window.
+     */
+    void draw(u8g2_uint_t x, u8g2_uint_t y);
+
+private:
+    static uint32_t hash(const char* text);
+    void render();
+
+    PixelUI& m_ui;
+    std::unique_ptr<uint8_t[]> _bitmap; // (_height + 7) / 8 pages of _width bytes
+    size_t _capacity = 0;
+    uint16_t _width = 0;
+    uint8_t _height = 0;
+    int16_t _left = 0;      // strip column 0 relative to the pen, negative if a glyph reaches left of it
+    int8_t _top = 0;        // strip row 0 relative to the baseline
+    bool _rasterized = false;
+
+    // what the strip holds
+    const char* _text = nullptr;
+    const uint8_t* _font = nullptr;
+    uint32_t _hash = 0;
+    uint16_t _textWidth = 0;
+};
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "config.h"
+#include "core/CommonTypes.h"
+
+/**
+ * @class Transition
+ * @brief Frame-driven blend from the last shown frame to newly rendered content.
+ *
+ * start() keeps a copy of the frame on screen. From then on apply() is called once per
+ * rendered frame, after the new content was drawn, and mixes the copy back into the
+ * frame buffer according to the time elapsed. Nothing blocks or sleeps; the transition
+ * simply ends on the first frame past its duration.
+ *
+ * With a page buffer there is no whole frame to copy: start() gets no frame, the new
+ * content then comes in over a blank screen, and apply() runs once per page.
+ */
+class Transition {
+public:
+    /**
+     * @brief Starts a transition away from the given frame.
+     * @param type The effect to play.
+     * @param duration Length in milliseconds, 0 for the default of the effect.
+     * @param currentTime Current UI time in milliseconds.
+     * @param frame The frame buffer as last shown, in u8g2 tile layout, nullptr to start from a blank screen.
+     * @param tileWidth Buffer width in 8x8 tiles.
+     * @param tileHeight Buffer height in 8x8 tiles.
+     */
+    void start(TransitionType type, uint32_t duration, uint32_t currentTime,
+               const uint8_t* frame, uint8_t tileWidth, uint8_t tileHeight);
+
+    /**
+     * @brief Blends the old frame into a freshly rendered buffer.
+     * @param buffer The frame buffer holding the new content.
+     * @param currentTime Current UI time in milliseconds.
+     * @param firstPage Page of the frame held in buffer[0], for page buffers.
+     * @param pages Pages held in buffer, 0 for the whole frame.
+     */
+    void apply(uint8_t* buffer, uint32_t currentTime, uint8_t firstPage = 0, uint8_t pages = 0);
+
+    bool isActive() const { return _active; }
+    void cancel() { _active = false; }
+
+private:
+    std::unique_ptr<uint8_t[]> _from; // the frame shown when the transition started
+    size_t _capacity = 0;
+    TransitionType _type = TransitionType::DITHER_FADE;
+    uint32_t _startTime = 0;
+    uint32_t _duration = 0;
+    uint8_t _tileWidth = 0;
+    uint8_t _tileHeight = 0;
+    bool _hasFrom = false; // false: the old frame is blank
+    bool _active = false;
+};
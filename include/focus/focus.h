@@ -19,6 +19,8 @@ private:
     uint32_t last_focus_change_time = 0; /**< The timestamp of the last focus change or user input. */
     FocusBox m_target_focus_box;         /**< The target coordinates and dimensions for the animation. */
     FocusBox m_current_focus_box = {0,64,0,0};        /**< The current coordinates and dimensions being animated. */
+    /** @brief Shrinks the focus box to its center, all four edges on one curve. */
+    VecAnimation<4> m_shrinkAnimation{m_current_focus_box.x, m_current_focus_box.y, m_current_focus_box.w, m_current_focus_box.h};
     
     /** @brief A pointer to the widget that is currently handling all input events. nullptr if no widget has control. */
     IWidget* m_activeWidget = nullptr;
@@ -54,7 +56,9 @@ public:
     void moveNext();
     /** @brief Moves the focus to the previous widget. */
     void movePrev();
-    /** @brief Handles all drawing and animation logic for the focus box. */
+    /** @brief Starts and ends the focus box animations, call it from the owner's update(). */
+    void update();
+    /** @brief Draws the focus box, without changing any state. */
     void draw();
 
     /**
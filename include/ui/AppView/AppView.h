@@ -21,6 +21,7 @@
 #include "core/app/app_system.h"
 #include "core/app/IApplication.h"
 #include "core/ViewManager/ViewManager.h"
+#include "core/layer/layer.h"
 
 class AppView : public IApplication {
 public:
@@ -71,6 +72,9 @@ private:
     int32_t animation_pixel_dots = 0;
     int32_t animation_scroll_bar= 0;
 
+    Layer titleLayer_;   // "< Apps >" header
+    Layer trackLayer_;   // dotted progress bar track, revealed by animation_pixel_dots
+
     int32_t selector_length = 30;
 
     void drawHorizontalAppList();
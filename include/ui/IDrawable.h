@@ -18,10 +18,45 @@
 #pragma once
 
 #include <cstdint>
+#include "config.h"
+#include "core/CommonTypes.h"
+#include "etl/vector.h"
+
+// Screen rectangles a drawable changed since its last frame, see IDrawable::getDamage().
+using DamageList = etl::vector<FocusBox, MAX_DAMAGE_RECTS>;
 
 class IDrawable {
 public:
+    /**
+     * @brief Draws the drawable into the frame buffer.
+     *
+     * In page buffer mode and for damage rectangles this runs several times per frame,
+     * once per page or rectangle, so state changes belong in update() instead.
+     */
     virtual void draw() = 0;
     virtual ~IDrawable() = default; 
-    virtual void update(uint32_t currentTime) {}
+
+    /**
+     * @brief Advances the drawable's own state, called once per Heartbeat() after the animations.
+     * @param currentTime UI time in milliseconds.
+     */
+    virtual void update(uint32_t /*currentTime*/) {}
+
+    /**
+     * @brief Frame rate this drawable needs on top of invalidation, for content that changes
+     * every frame without going through the animation manager (e.g. a rotating 3D model).
+     * @return Frames per second, 0 to render only when something was invalidated (the default).
+     */
+    virtual uint16_t getFrameRate() const { return 0; }
+
+    /**
+     * @brief Reports the regions that changed since the previous frame.
+     *
+     * Called once before every rendered frame. When it returns true, the renderer clears
+     * and redraws only the listed rectangles, with draw() clipped to each of them, so
+     * draw() must not have side effects. An empty list skips the frame.
+     * @param damage Receives the changed rectangles.
+     * @return false to request a full redraw (the default).
+     */
+    virtual bool getDamage(DamageList& /*damage*/) { return false; }
 };
\ No newline at end of file
@@ -24,6 +24,8 @@
 #include "etl/vector.h"
 #include "etl/delegate.h"
 #include "core/animation/animation.h"
+#include "core/text/text_strip.h"
+#include <assert.h>
 
 // Struct to hold extra data for a list item, like values for switches or sliders.
 struct ListItemExtra{
@@ -51,6 +53,7 @@ public:
              ListItemExtra ex = {})
         : nextList(next), nextListLength(nextLen), pFunc(func), extra(ex)
     {
+        assert(strlen(title) < sizeof(Title)); // raise MAX_LISTITEM_NAME_NUM instead of losing the end of a title
         strncpy(Title, title, sizeof(Title));
         Title[sizeof(Title)-1] = 0; // Ensure null-termination.
     }
@@ -63,11 +66,13 @@ public:
 class ListView : public IApplication {
 public:
     // Constructor to initialize the list view with a UI handler and a list of items.
-    ListView(PixelUI& ui, ListItem *itemList, size_t length) : m_ui(ui), m_itemList(itemList), m_itemLength(length - 1) {}
+    ListView(PixelUI& ui, ListItem *itemList, size_t length) : m_ui(ui), m_itemList(itemList), m_itemLength(length - 1), marquee_(ui) {}
     ~ListView() = default;
 
     // --- Application Lifecycle and Input Handlers ---
     void draw() override;
+    void update(uint32_t currentTime) override;
+    bool getDamage(DamageList& damage) override;
     bool handleInput(InputEvent event) override;
     void onEnter(ExitCallback exitCallback) override;
     void onResume() override ;
@@ -104,6 +109,7 @@ private:
     // --- Load Animation Variables ---
     int32_t itemLoadAnimations_[LISTVIEW_ITEMS_PER_PAGE + 1]; // Tracks animation progress for each item.
     bool isInitialLoad_ = true;
+    Timeline loadTimeline_;               // Staggers the item load animations.
     int32_t animation_pixel_dots = 0;
     int32_t animation_scroll_bar = 0;
     
@@ -123,6 +129,37 @@ private:
     int32_t progress_bar_top = 0;
     int32_t progress_bar_bottom = 0;
 
+    // --- Marquee Variables ---
+    // The selected title scrolls when it is wider than its row.
+    TextStrip marquee_;                   // the selected title, rasterized once
+    Timeline marqueeTimeline_;
+    int32_t marqueeOffset_ = 0;
+    uint16_t marqueeWidth_ = 0;           // width of the title the marquee was started for
+    FocusBox marqueeBox_ = {0, 0, 0, 0};  // row of the selected title, before scrolling
+
+    // --- Damage Tracking Variables ---
+    // What the last frame was drawn from, compared by getDamage().
+    struct DrawnState {
+        ListItem* itemList = nullptr;
+        size_t itemLength = 0;
+        int32_t scrollOffset = 0;
+        bool loading = false;
+        uint32_t titleHash = 0;   // titles of the rows in view
+        uint32_t valueHash = 0;   // switch and int values of the rows in view
+        int32_t switchBoxX = 0;
+        int32_t cursorY = 0;
+        int32_t cursorWidth = 0;
+        size_t cursor = 0;
+        int32_t barTop = 0;
+        int32_t barBottom = 0;
+        int32_t marqueeOffset = 0;
+        bool marquee = false;     // the selected title scrolls
+    };
+    DrawnState drawn_;
+    bool hasDrawn_ = false;
+    static constexpr int32_t VALUE_COLUMN_WIDTH = 35; // switches, values, "BACK"/">>" label and progress bar
+    static constexpr int32_t TITLE_X = 4;
+
     // --- Navigation and Drawing Methods ---
     void navigateLeft();
     void navigateRight();
@@ -130,6 +167,9 @@ private:
     void navigateDown();
 
     void drawCursor();
+    void drawTitle(const ListItem& item, bool selected, int32_t x, int32_t y);
+    int32_t titleRight(const ListItem& item) const;
+    void restartMarquee();
     void scrollToTarget(size_t target);
     void updateScrollPosition();
     void startLoadAnimation();
@@ -137,11 +177,10 @@ private:
     int getVisibleItemIndex(int screenIndex);
     bool shouldScroll(int newCursor);
     int32_t calculateItemY(int itemIndex);
+    DrawnState captureDrawnState() const;
     
     void selectCurrent();
     void returnToPreviousContext();
-
-    void clearNonInitialAnimations();
     
     size_t currentCursor = 0; // The index of the currently selected item.
 };
\ No newline at end of file
@@ -19,8 +19,10 @@
 
 #include <functional>
 #include <cstdint>
+#include <memory>
 #include "core/CommonTypes.h"
 #include "etl/vector.h"
+#include "core/text/text_layout.h"
 #include "config.h"
 
 class PixelUI;
@@ -64,6 +66,24 @@ public:
      * @return The duration in milliseconds.
      */
     virtual uint16_t getDuration() const = 0;
+
+    /**
+     * @brief Gets the area the popup paints completely, hiding everything below it.
+     * @return False if the popup currently covers nothing.
+     */
+    virtual bool getBounds(FocusBox& /*area*/) const { return false; }
+
+    /**
+     * @brief Whether the next frame would show the popup exactly as the last one did.
+     * Settled popups are copied from the pixels kept by the PopupManager instead of drawn.
+     */
+    virtual bool isSettled() const { return false; }
+
+    /**
+     * @brief Called once after every fully drawn frame, when draw() has run for all pages.
+     * The place to note what the frame showed, as draw() may run several times per frame.
+     */
+    virtual void onFrameRendered() {}
 };
 
 /**
@@ -113,6 +133,8 @@ public:
     bool update(uint32_t currentTime) override;
     void draw() override;
     bool handleInput(InputEvent event) override;
+    bool getBounds(FocusBox& area) const override;
+    bool isSettled() const override { return _state == PopupState::SHOWING; }
     
     // Abstract method for subclasses to implement their specific content drawing
     virtual void drawContent(int16_t centerX, int16_t centerY, int16_t currentWidth, int16_t currentHeight) = 0;
@@ -128,20 +150,13 @@ private:
     const char *_title;
     const char *_text;
     
-    // ESP32-C6 memory-optimized text handling
-    static const uint16_t MAX_LINES = 6;  // Reduced from 8 to 6 to save memory
     static const uint16_t LINE_HEIGHT = 9; // Line height in pixels
     static const uint16_t TEXT_MARGIN = 4; // Reduced from 6 to 4 to save space
     
-    struct TextLine {
-        const char* start;
-        uint16_t length;
-    };
-    
-    TextLine _textLines[MAX_LINES];
+    TextLayout _layout; // lines of _text, wrapped to the popup width
     uint16_t _lineCount;
 
-    uint16_t splitTextIntoLines(const char* text, uint16_t maxWidth);
+    uint16_t layoutText();
     
 public:
     PopupInfo(PixelUI& ui, uint16_t width, uint16_t height, 
@@ -160,6 +175,14 @@ private:
     // A vector to store popups, sorted by priority.
     etl::vector<std::shared_ptr<IPopup>, MAX_POPUP_NUM> _popups;
     PixelUI& m_ui;
+
+    // pixels of a settled popup, copied back instead of drawing it again
+    std::unique_ptr<uint8_t[]> _cache;
+    size_t _cacheCapacity = 0;
+    FocusBox _cacheArea = {0, 0, 0, 0};
+    bool _cacheValid = false;
+
+    bool getCacheableArea(FocusBox& area) const;
     
 public:
     PopupManager(PixelUI& ui) : m_ui(ui) {}
@@ -172,6 +195,22 @@ public:
     void updatePopups(uint32_t currentTime);
     bool handleTopPopupInput(InputEvent event);
     size_t getPopupCounts() const { return _popups.size(); }
+
+    /**
+     * @brief Gets the area hidden under the largest popup, which the drawable below may skip.
+     * @return False if no popup covers anything.
+     */
+    bool getOccludedArea(FocusBox& area) const;
+
+    /**
+     * @brief True if the next drawPopups() only copies kept pixels and changes nothing on screen.
+     */
+    bool isCached() const;
+
+    /**
+     * @brief Tells every popup that a frame with all of them drawn is complete.
+     */
+    void onFrameRendered();
 };
 
 /**
@@ -181,6 +220,7 @@ public:
 class PopupProgress : public PopupBase {
 private:
     int32_t& _value;
+    int32_t _drawnValue;  // the value shown by the last rendered frame
     int32_t _minValue, _maxValue;
     const char* _title;
     
@@ -219,4 +259,6 @@ public:
 
     void drawContent(int16_t centerX, int16_t centerY, int16_t currentWidth, int16_t currentHeight) override;
     bool handleInput(InputEvent event) override;
+    bool isSettled() const override { return PopupBase::isSettled() && _value == _drawnValue; }
+    void onFrameRendered() override { _drawnValue = _value; }
 };
\ No newline at end of file
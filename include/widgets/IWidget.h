@@ -52,6 +52,14 @@ public:
     bool isFocusable() { return focusable; }
     void setFocusable(bool state) { focusable = state; }
 
+    /**
+     * @brief Reports the regions this widget changed since it was last drawn.
+     * Lets the owning view forward widget damage from its own IDrawable::getDamage().
+     * @param damage Receives the changed rectangles.
+     * @return false if the widget cannot tell and must be fully redrawn.
+     */
+    virtual bool getDamage(DamageList& /*damage*/) { return false; }
+
     void setFocusBox(const FocusBox& pos) {focus = pos;}
     FocusBox getFocusBox() { return focus; }
 };
\ No newline at end of file
@@ -66,6 +66,7 @@ private:
     int32_t anim_h = 0;
     int32_t anim_x = 0;
     int32_t anim_y = 0;
+    VecAnimation<4> m_boxAnimation{anim_w, anim_h, anim_x, anim_y};
     void expandWidget();
     void contractWidget();
     void calculateExpandPosition(int32_t& target_x, int32_t& target_y);
@@ -23,7 +23,6 @@
 #include <stddef.h>
 
 #include "QApplication"
-#include <QTimer>
 
 #include "MainWindow.h"
 #include "EmuWorker.h"
@@ -47,18 +46,18 @@ public:
     ui.begin();
     auto appView = std::make_shared<AppView>(ui, *ui.getViewManagerPtr());
     ui.getViewManagerPtr()->push(appView);
+    auto startTime = std::chrono::steady_clock::now();
         while (running) {
-
-            bool isDirty = ui.isDirty();
-        
             auto eventOpt = g_mainWindow->popInputEvent();
             if (eventOpt.has_value()) {
                 ui.handleInput(eventOpt.value());
             }
 
-            ui.renderer();
-        
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            // logic ticks and rendering on one thread, paced by the same clock
+            auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+            ui.runFrame(static_cast<uint32_t>(now.count()));
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
         }
     }
 };
@@ -83,13 +82,6 @@ int main(int argc, char *argv[]) {
         w.update(); 
     });
 
-    QTimer* hbTimer = new QTimer();
-    QObject::connect(hbTimer, &QTimer::timeout, [&](){
-        ui.Heartbeat(16);
-    });
-
-    hbTimer->start(16); // 16ms = ~60FPS
-
     EmulatorThread *worker_ptr = &worker;
 
     // display.setUpdateCallback([worker_ptr]() {
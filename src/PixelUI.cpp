@@ -18,9 +18,13 @@
 #include "PixelUI.h"
 #include "core/ViewManager/ViewManager.h"
 #include <functional>
+#include <algorithm>
+#include <cstring>
+#include <assert.h>
 #include "core/app/app_system.h"
 #include "core/animation/animation.h"
 #include "ui/Popup/Popup.h"
+#include "core/blit/blitter.h"
 
 /**
  * @class PixelUI
@@ -29,7 +33,7 @@
  * Handles the central logic for UI rendering, animation management,
  * and event handling.
  */
-PixelUI::PixelUI(U8G2& u8g2) : u8g2_(u8g2), _currentTime(0) {
+PixelUI::PixelUI(U8G2& u8g2) : u8g2_(u8g2), _currentTime(0), textMetrics_(u8g2), glyphCache_(u8g2) {
     m_viewManagerPtr = std::make_shared<ViewManager>(*this);
     m_animationManagerPtr = std::make_shared<AnimationManager>();
     m_popupManagerPtr = std::make_shared<PopupManager>(*this);
@@ -49,8 +53,101 @@ void PixelUI::begin() {
 void PixelUI::Heartbeat(uint32_t ms) 
 {
     _currentTime += ms;
-    m_animationManagerPtr->update(_currentTime);
+    if (m_animationManagerPtr->update(_currentTime)) {
+        markDirty();
+    }
     m_popupManagerPtr->updatePopups(_currentTime);
+
+    // views animating on their own (not through the animation manager) ask for a frame rate
+    uint16_t frameRate = currentDrawable_ ? currentDrawable_->getFrameRate() : 0;
+    if (frameRate) {
+        uint32_t period = 1000 / frameRate;
+        if (_currentTime - lastPacedFrameTime_ >= period) {
+            // keep the average rate when ticks do not divide the period, but never run ahead after a stall
+            lastPacedFrameTime_ += period;
+            if (_currentTime - lastPacedFrameTime_ >= period) lastPacedFrameTime_ = _currentTime;
+            markDirty();
+        }
+    }
+
+    if (wakePending_ && (int32_t)(_currentTime - wakeTime_) >= 0) {
+        wakePending_ = false;
+        markDirty();
+    }
+
+    // last, as the drawable may leave its view here; the copy keeps it alive until update() returns
+    if (std::shared_ptr<IDrawable> drawable = currentDrawable_) drawable->update(_currentTime);
+}
+
+/**
+ * @brief Invalidates the screen once ms milliseconds of UI time have passed.
+ * @param ms Delay in milliseconds.
+ */
+void PixelUI::invalidateAfter(uint32_t ms) {
+    uint32_t wakeTime = _currentTime + ms;
+    if (!wakePending_ || (int32_t)(wakeTime - wakeTime_) < 0) {
+        wakeTime_ = wakeTime;
+        wakePending_ = true;
+    }
+}
+
+/**
+ * @brief Run one iteration of a frame-paced main loop.
+ *
+ * Logic advances in fixed ticks, as many as the time since the last call
+ * covers, so animations keep their speed however irregularly this is called.
+ * After a stall at most maxCatchUpTicks ticks run and the rest of the backlog
+ * is dropped instead of fast-forwarded. A frame is rendered only if a tick
+ * ran or something was marked dirty, and is dropped while the display busy
+ * callback reports the bus still busy with the previous one.
+ * @param now Monotonic time in milliseconds.
+ * @return True if a frame was rendered.
+ */
+bool PixelUI::runFrame(uint32_t now) {
+    if (!framePacingStarted_) {
+        framePacingStarted_ = true;
+        lastFrameTime_ = now;
+        statsWindowStart_ = now;
+    }
+    tickBacklog_ += now - lastFrameTime_;
+    lastFrameTime_ = now;
+
+    uint32_t ticks = 0;
+    while (tickBacklog_ >= tickMs_ && ticks < maxCatchUpTicks_) {
+        Heartbeat(tickMs_);
+        tickBacklog_ -= tickMs_;
+        ++ticks;
+    }
+    if (tickBacklog_ >= tickMs_) {
+        frameStats_.droppedTicks += tickBacklog_ / tickMs_;
+        tickBacklog_ %= tickMs_;
+    }
+
+    bool rendered = false;
+    bool pending = isDirty_ || transition_.isActive();
+    if (pending && (ticks || isDirty_)) {
+        if (flushBusy_ || (m_displayBusyCallback && m_displayBusyCallback())) {
+            // polling while the bus is busy only delays the frame, a tick makes one go unseen
+            if (ticks) ++frameStats_.droppedFrames;
+        } else {
+            renderer();
+            rendered = true;
+        }
+    }
+
+    windowTicks_ += ticks;
+    windowFrames_ += rendered;
+    uint32_t window = now - statsWindowStart_;
+    if (window >= 1000) {
+        frameStats_.tickRate = windowTicks_ * 1000 / window;
+        frameStats_.frameRate = windowFrames_ * 1000 / window;
+        frameStats_.tilesPerFrame = windowFrames_ ? windowTiles_ / windowFrames_ : 0;
+        windowTiles_ = 0;
+        windowTicks_ = 0;
+        windowFrames_ = 0;
+        statsWindowStart_ = now;
+    }
+    return rendered;
 }
 
 /** * @brief Add an animation to the manager and start it.
@@ -68,16 +165,10 @@ void PixelUI::addAnimation(std::shared_ptr<Animation> animation) {
  * @param duration animation duration (milliseconds).
  * @param easing easing type.
  * @param prot animation protection status.
+ * @return handle of the pooled tween driving the value.
  */
-void PixelUI::animate(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing, PROTECTION prot) {
-    auto animation = std::make_shared<CallbackAnimation>(
-        value, targetValue, duration, easing,
-        [&value](int32_t currentValue) {
-            value = currentValue;
-        }
-    );
-    if (prot == PROTECTION::PROTECTED) m_animationManagerPtr->markProtected(animation);
-    addAnimation(animation);
+AnimationHandle PixelUI::animate(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing, PROTECTION prot) {
+    return m_animationManagerPtr->animate(value, targetValue, duration, easing, _currentTime, prot);
 }
 
 /**
@@ -91,28 +182,8 @@ void PixelUI::animate(int32_t& value, int32_t targetValue, uint32_t duration, Ea
  * @param prot animation protection status.
  */
 void PixelUI::animate(int32_t& x, int32_t& y, int32_t targetX, int32_t targetY, uint32_t duration, EasingType easing, PROTECTION prot) {
-    // animate X
-    auto animX = std::make_shared<CallbackAnimation>(
-        x, targetX, duration, easing,
-        [&x](int32_t currentValue) {
-            x = currentValue;
-        }
-    );
-    addAnimation(animX);
-
-    // animate Y
-    auto animY = std::make_shared<CallbackAnimation>(
-        y, targetY, duration, easing,
-        [&y](int32_t currentValue) {
-            y = currentValue;
-        }
-    );
-    addAnimation(animY);
-
-    if (prot == PROTECTION::PROTECTED) {
-        m_animationManagerPtr->markProtected(animX);
-        m_animationManagerPtr->markProtected(animY);
-    }
+    m_animationManagerPtr->animate(x, targetX, duration, easing, _currentTime, prot);
+    m_animationManagerPtr->animate(y, targetY, duration, easing, _currentTime, prot);
 }
 
 
@@ -123,42 +194,288 @@ void PixelUI::animate(int32_t& x, int32_t& y, int32_t targetX, int32_t targetY,
  * including the current drawable content and any active popups.
  */
 void PixelUI::renderer() {
-    if (getActiveAnimationCount() || isContinousRefreshEnabled()) {
+    if (transition_.isActive()) {
         markDirty();
     }
+    // the previous frame is still sent from the second buffer, this one stays pending until it is free
+    if (flushBusy_) return;
     if (isDirty()) {
-        if (!isFading_){
-            this->getU8G2().clearBuffer();
-            
-            // current drawable content controlled by applications
-            if (currentDrawable_ && isDirty()) {
-                currentDrawable_->draw();
-                isDirty_ = false;
-            }
-            
-            // render popups on top of everything else
-            m_popupManagerPtr->drawPopups();
+        // the drawable is asked every frame so its damage always refers to the last drawn frame
+        DamageList damage;
+        bool partial = currentDrawable_ && currentDrawable_->getDamage(damage);
+        bool hasPopups = m_popupManagerPtr->getPopupCounts() > 0;
+        // a popup copied from its kept pixels looks as it did, anything else about popups needs a full frame
+        bool popupsChanged = hasPopups ? !m_popupManagerPtr->isCached() : popupsOnScreen_;
+        popupsOnScreen_ = hasPopups;
+        if (partial && !fullRedraw_ && !popupsChanged && !transition_.isActive() && renderDamage(damage)) {
+            isDirty_ = false;
+            return;
+        }
+        // transitions are not damage tracked, the frame after them is redrawn fully too
+        fullRedraw_ = transition_.isActive();
 
-            this->getU8G2().sendBuffer();
+        if (isPageBufferMode()) {
+            renderPages();
+            isDirty_ = false;
+            m_popupManagerPtr->onFrameRendered();
             if (m_refresh_callback) m_refresh_callback();
-        } else {
-            uint8_t * buf_ptr = this->getU8G2().getBufferPtr();
-            uint16_t buf_len = 1024;
-            for (int fade = 1; fade <= 4; fade++){
-                switch (fade)
-                {
-                    case 1: for (uint16_t i = 0; i < buf_len; ++i)  if (i % 2 != 0) buf_ptr[i] = buf_ptr[i] & 0xAA; break;
-                    case 2: for (uint16_t i = 0; i < buf_len; ++i)  if (i % 2 != 0) buf_ptr[i] = buf_ptr[i] & 0x00; break;
-                    case 3: for (uint16_t i = 0; i < buf_len; ++i)  if (i % 2 == 0) buf_ptr[i] = buf_ptr[i] & 0x55; break;
-                    case 4: for (uint16_t i = 0; i < buf_len; ++i)  if (i % 2 == 0) buf_ptr[i] = buf_ptr[i] & 0x00; break;
+            return;
+        }
+
+        this->getU8G2().clearBuffer();
+        
+        // current drawable content controlled by applications
+        if (currentDrawable_ && isDirty()) {
+            drawDrawable();
+            isDirty_ = false;
+        }
+
+        // blend in the previous screen while a transition runs
+        transition_.apply(this->getU8G2().getBufferPtr(), _currentTime);
+        
+        // render popups on top of everything else
+        m_popupManagerPtr->drawPopups();
+
+        flushBuffer();
+        m_popupManagerPtr->onFrameRendered();
+        if (m_refresh_callback) m_refresh_callback();
+    }
+}
+
+/**
+ * @brief Renders one frame through a u8g2 page buffer.
+ *
+ * The drawable, the transition and the popups run once per page; u8g2 drops every
+ * draw call outside the page, and nextPage() sends each page as soon as it is done.
+ */
+void PixelUI::renderPages() {
+    U8G2& u8g2 = getU8G2();
+    u8g2.firstPage();
+    do {
+        if (currentDrawable_) drawDrawable();
+        transition_.apply(u8g2.getBufferPtr(), _currentTime, u8g2.getBufferCurrTileRow(), u8g2.getBufferTileHeight());
+        m_popupManagerPtr->drawPopups();
+    } while (u8g2.nextPage());
+
+    const u8x8_display_info_t* info = u8g2.getU8x8()->display_info;
+    uint32_t tiles = info->tile_width * info->tile_height;
+    frameStats_.tilesSent += tiles;
+    windowTiles_ += tiles;
+}
+
+/**
+ * @brief Draws the current drawable, with the area hidden under popups reported as not visible.
+ */
+void PixelUI::drawDrawable() {
+    occlusionActive_ = m_popupManagerPtr->getOccludedArea(occluded_);
+    currentDrawable_->draw();
+    occlusionActive_ = false;
+}
+
+bool PixelUI::isPageBufferMode() const {
+    U8G2& u8g2 = getU8G2();
+    return u8g2.getBufferTileHeight() < u8g2.getU8x8()->display_info->tile_height;
+}
+
+bool PixelUI::isAreaVisible(int32_t x, int32_t y, int32_t w, int32_t h) const {
+    const u8g2_t* u8g2 = getU8G2().getU8g2();
+    if (!u8g2->is_page_clip_window_intersection || w <= 0 || h <= 0) return false;
+    if (occlusionActive_ && x >= occluded_.x && y >= occluded_.y
+        && x + w <= occluded_.x + occluded_.w && y + h <= occluded_.y + occluded_.h) return false;
+    return x < u8g2->user_x1 && x + w > u8g2->user_x0 && y < u8g2->user_y1 && y + h > u8g2->user_y0;
+}
+
+/**
+ * @brief Starts a transition from the screen currently shown to whatever is rendered next.
+ * @param type The effect to play.
+ * @param duration Length in milliseconds, 0 for the default of the effect.
+ */
+void PixelUI::startTransition(TransitionType type, uint32_t duration) {
+    U8G2& u8g2 = getU8G2();
+    // a page buffer only holds the last page sent, so the new screen comes in over a blank one
+    const uint8_t* frame = isPageBufferMode() ? nullptr : u8g2.getBufferPtr();
+    transition_.start(type, duration, _currentTime, frame,
+                      u8g2.getBufferTileWidth(), u8g2.getU8x8()->display_info->tile_height);
+    markDirty();
+}
+
+/**
+ * @brief Redraws only the damaged regions of the current drawable.
+ *
+ * Each rectangle is widened to whole 8x8 display tiles, overlapping ones are merged,
+ * then every region is cleared, redrawn through the clip window and flushed with
+ * updateDisplayArea().
+ * @param damage Rectangles reported by the drawable, modified in place.
+ * @return false if the damage covers so much of the screen that a full redraw is cheaper.
+ */
+bool PixelUI::renderDamage(DamageList& damage) {
+    U8G2& u8g2 = getU8G2();
+    const int32_t screenW = u8g2.getDisplayWidth();
+    const int32_t screenH = u8g2.getDisplayHeight();
+
+    // snap to tiles and clamp to the screen, dropping rectangles that end up empty
+    for (size_t i = 0; i < damage.size();) {
+        FocusBox& r = damage[i];
+        int32_t x0 = std::max<int32_t>(0, r.x) & ~7;
+        int32_t y0 = std::max<int32_t>(0, r.y) & ~7;
+        int32_t x1 = (std::min(screenW, r.x + r.w) + 7) & ~7;
+        int32_t y1 = (std::min(screenH, r.y + r.h) + 7) & ~7;
+        if (r.w <= 0 || r.h <= 0 || x0 >= x1 || y0 >= y1) {
+            damage.erase(damage.begin() + i);
+            continue;
+        }
+        r = {x0, y0, x1 - x0, y1 - y0};
+        ++i;
+    }
+
+    // merge overlapping rectangles into their bounding box until none overlap
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (size_t i = 0; i < damage.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < damage.size(); ++j) {
+                FocusBox& a = damage[i];
+                const FocusBox& b = damage[j];
+                if (a.x >= b.x + b.w || b.x >= a.x + a.w || a.y >= b.y + b.h || b.y >= a.y + a.h) continue;
+                int32_t x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+                int32_t x1 = std::max(a.x + a.w, b.x + b.w), y1 = std::max(a.y + a.h, b.y + b.h);
+                a = {x0, y0, x1 - x0, y1 - y0};
+                damage.erase(damage.begin() + j);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    int32_t area = 0;
+    for (const FocusBox& r : damage) area += r.w * r.h;
+    if (area * 4 > screenW * screenH * 3) return false;
+    if (damage.empty()) return true; // nothing changed, keep the panel as it is
+
+    const uint8_t bufferPages = u8g2.getBufferTileHeight();
+    for (const FocusBox& r : damage) {
+        u8g2.setClipWindow(r.x, r.y, r.x + r.w, r.y + r.h);
+        if (isPageBufferMode()) {
+            // bring each page of the rectangle into the buffer, redraw it there and send its tiles
+            const size_t stride = (size_t)u8g2.getBufferTileWidth() * 8;
+            for (int32_t page = r.y / 8; page < (r.y + r.h) / 8; page += bufferPages) {
+                uint8_t pages = std::min<int32_t>(bufferPages, (r.y + r.h) / 8 - page);
+                u8g2_SetBufferCurrTileRow(u8g2.getU8g2(), page);
+                Blitter::fillRect(u8g2.getBufferPtr(), u8g2.getBufferTileWidth(), r.x, 0, r.w, pages, 0);
+                drawDrawable();
+                for (uint8_t p = 0; p < pages; ++p) {
+                    u8x8_DrawTile(u8g2.getU8x8(), r.x / 8, page + p, r.w / 8, u8g2.getBufferPtr() + p * stride + r.x);
+                }
+            }
+            uint32_t tiles = (r.w / 8) * (r.h / 8);
+            frameStats_.tilesSent += tiles;
+            windowTiles_ += tiles;
+            continue;
+        }
+        Blitter::fillRect(u8g2.getBufferPtr(), u8g2.getBufferTileWidth(), r.x, r.y / 8, r.w, r.h / 8, 0);
+        drawDrawable();
+        m_popupManagerPtr->drawPopups(); // only a kept popup gets here, copied back over the redrawn area
+        // tile diffing and async flushing handle the whole frame below
+        if (flushMode_ == FlushMode::FULL && !m_asyncFlushCallback) {
+            u8g2.updateDisplayArea(r.x / 8, r.y / 8, r.w / 8, r.h / 8);
+            uint32_t tiles = (r.w / 8) * (r.h / 8);
+            frameStats_.tilesSent += tiles;
+            windowTiles_ += tiles;
+        }
+    }
+    u8g2.setMaxClipWindow();
+    if (flushMode_ == FlushMode::TILE_DIFF || m_asyncFlushCallback) flushBuffer();
+    if (m_refresh_callback) m_refresh_callback();
+    return true;
+}
+
+/**
+ * @brief Selects how frames are transferred to the display.
+ * @param mode The new flush mode.
+ */
+void PixelUI::setFlushMode(FlushMode mode) {
+    // diffing needs the whole last frame, which a page buffer never holds
+    assert(mode == FlushMode::FULL || !isPageBufferMode());
+    if (mode != FlushMode::FULL && isPageBufferMode()) return;
+    flushMode_ = mode;
+    lastFlushedValid_ = false;
+    if (mode == FlushMode::FULL) {
+        lastFlushed_.reset();
+        return;
+    }
+    if (!lastFlushed_) {
+        U8G2& u8g2 = getU8G2();
+        lastFlushed_.reset(new uint8_t[u8g2.getBufferTileWidth() * u8g2.getBufferTileHeight() * 8]);
+    }
+}
+
+/**
+ * @brief Hands finished frames to an asynchronous transmitter instead of sendBuffer().
+ * @param callback The transmitter, nullptr to go back to sendBuffer().
+ */
+void PixelUI::setAsyncFlushCallback(AsyncFlushCallback callback) {
+    assert(!flushBusy_); // the frame in flight may still be read from the second buffer
+    assert(!callback || !isPageBufferMode()); // pages are sent by nextPage() as they are drawn
+    if (callback && isPageBufferMode()) return;
+    m_asyncFlushCallback = callback;
+    lastFlushedValid_ = false; // the panel no longer shows the frame TILE_DIFF compares against
+    if (!callback) {
+        flushingBuffer_.reset();
+        return;
+    }
+    if (!flushingBuffer_) {
+        U8G2& u8g2 = getU8G2();
+        flushingBuffer_.reset(new uint8_t[u8g2.getBufferTileWidth() * u8g2.getBufferTileHeight() * 8]);
+    }
+    markDirty();
+}
+
+/**
+ * @brief Transfers the frame buffer to the display according to the flush mode.
+ *
+ * In FlushMode::TILE_DIFF every tile row is compared with the last transmitted
+ * frame, and each run of changed tiles goes out with one updateDisplayArea() call.
+ */
+void PixelUI::flushBuffer() {
+    U8G2& u8g2 = getU8G2();
+    const uint8_t tileW = u8g2.getBufferTileWidth();
+    const uint8_t tileH = u8g2.getBufferTileHeight();
+    uint8_t* buf = u8g2.getBufferPtr();
+
+    uint32_t tiles = 0;
+    if (m_asyncFlushCallback) {
+        // renderer() only gets here once the previous transfer completed
+        Blitter::copy(flushingBuffer_.get(), buf, tileW * tileH * 8);
+        tiles = tileW * tileH;
+        flushBusy_ = true;
+        lastFlushedValid_ = false; // sent whole, the first flush after async is a full one
+        m_asyncFlushCallback(flushingBuffer_.get(), tileW, tileH);
+    } else if (flushMode_ == FlushMode::FULL || !lastFlushed_ || !lastFlushedValid_) {
+        u8g2.sendBuffer();
+        tiles = tileW * tileH;
+        if (lastFlushed_) {
+            memcpy(lastFlushed_.get(), buf, tileW * tileH * 8);
+            lastFlushedValid_ = true;
+        }
+    } else {
+        for (uint8_t ty = 0; ty < tileH; ++ty) {
+            uint8_t* row = buf + ty * tileW * 8;
+            uint8_t* last = lastFlushed_.get() + ty * tileW * 8;
+            uint8_t tx = 0;
+            while (tx < tileW) {
+                if (!memcmp(row + tx * 8, last + tx * 8, 8)) {
+                    ++tx;
+                    continue;
                 }
-                this->getU8G2().sendBuffer();
-                if (m_refresh_callback) m_refresh_callback();
-                m_func_delay(40);
+                uint8_t start = tx;
+                while (tx < tileW && memcmp(row + tx * 8, last + tx * 8, 8)) ++tx;
+                u8g2.updateDisplayArea(start, ty, tx - start, 1);
+                memcpy(last + start * 8, row + start * 8, (tx - start) * 8);
+                tiles += tx - start;
             }
-            isFading_ = false;
         }
     }
+    frameStats_.tilesSent += tiles;
+    windowTiles_ += tiles;
 }
 
 /**
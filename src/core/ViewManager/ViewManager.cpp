@@ -25,11 +25,14 @@ void ViewManager::push(std::shared_ptr<IApplication> app) {
         std::lock_guard<std::mutex> lock(m_stackMutex);
         m_isTransitioning = true;
 
+        auto animations = m_ui.getAnimationManPtr();
         if (!m_viewStack.empty()) {
             m_viewStack.top()->onPause(); // Pause the current top application
+            animations->suspend(m_viewStack.top().get(), m_ui.getCurrentTime()); // and freeze its animations
         }
 
         m_viewStack.push(app);    // Push the new application onto the stack
+        animations->setScope(app.get()); // Animations started from now on belong to the new app
         m_ui.setDrawable(app);    // Grant app with drawable control
         
         app->onEnter([this]() {this->pop();}); // Handle app with exit callback
@@ -46,15 +49,20 @@ void ViewManager::pop() {
 
     if (m_viewStack.empty()) return;
     
+    auto animations = m_ui.getAnimationManPtr();
     m_viewStack.top()->onExit(); // call exit callback of the top app
+    animations->cancel(m_viewStack.top().get()); // its animations must not outlive it
     m_viewStack.pop(); 
 
     if (!m_viewStack.empty()) {
         auto& previousApp = m_viewStack.top();
+        animations->setScope(previousApp.get());
+        animations->resume(previousApp.get(), m_ui.getCurrentTime()); // continue where it was paused
         m_ui.setDrawable( previousApp );
         previousApp->onResume(); // resume the previous application
     }
     else {
+        animations->setScope(nullptr);
         m_ui.setDrawable(nullptr);
     }
     m_ui.markDirty();
@@ -17,10 +17,55 @@
 
 #include "core/animation/animation.h"
 #include <assert.h>
+#include <algorithm>
+#include <cstdlib>
 
 // Convert float multiplication to integer multiplication and bit shift
 #define MUL_FIXED(a, b) ((int64_t)(a) * (b) >> SHIFT_BITS)
 
+// Time window (milliseconds) used to sample a tween's velocity when it is retargeted
+#define VELOCITY_SAMPLE_MS 16
+
+// A spring is at rest once it is closer than this to its target and moves less than it per sample window
+#define SPRING_REST_THRESHOLD (FIXED_POINT_ONE / 4)
+
+// Natural frequency times settle time, a critically damped spring covers 99.5% of its way in that time
+#define SPRING_SETTLE_OMEGA_T FLOAT_TO_FIXED(7.5f)
+
+static_assert(MAX_ANIMATION_COUNT <= UINT8_MAX, "tween pool indices are stored as uint8_t");
+static_assert(MAX_TIMELINE_STEPS <= 32, "timeline steps are tracked in a 32-bit mask");
+
+namespace {
+
+/**
+ * @brief Lookup tables for every non-linear easing type, sampled from the exact math.
+ *
+ * Entry i holds the progress at t = i / EASING_LUT_SIZE, so each row has
+ * EASING_LUT_SIZE + 1 entries including t = 1. LINEAR needs no table.
+ */
+struct EasingLut {
+    int16_t table[EASING_TYPE_COUNT - 1][EASING_LUT_SIZE + 1];
+};
+
+constexpr EasingLut makeEasingLut() {
+    EasingLut lut{};
+    for (int type = 1; type < EASING_TYPE_COUNT; ++type) {
+        for (int i = 0; i <= EASING_LUT_SIZE; ++i) {
+            int32_t t = (i * FIXED_POINT_ONE) / EASING_LUT_SIZE;
+            lut.table[type - 1][i] = static_cast<int16_t>(EasingCalculator::calculateExact(static_cast<EasingType>(type), t));
+        }
+    }
+    return lut;
+}
+
+constexpr EasingLut EASING_LUT = makeEasingLut();
+
+static_assert(EASING_LUT_SIZE <= FIXED_POINT_ONE, "EASING_LUT_BITS must not exceed SHIFT_BITS");
+static_assert(EASING_LUT.table[static_cast<int>(EasingType::EASE_OUT_CUBIC) - 1][EASING_LUT_SIZE] == FIXED_POINT_ONE,
+              "easing tables must end at 1.0");
+
+} // namespace
+
 /**
  * @brief Easing function implementation, all calculations use fixed-point numbers.
  * @param type Easing type.
@@ -29,72 +74,33 @@
  */
 int32_t EasingCalculator::calculate(EasingType type, int32_t t) 
 {
-    switch (type) 
-    {
-        case EasingType::LINEAR:            return t;
-        case EasingType::EASE_IN_QUAD:      return MUL_FIXED(t, t);
-        case EasingType::EASE_OUT_QUAD:     
-        {
-            int32_t inverse_t = FIXED_POINT_ONE - t;
-            return FIXED_POINT_ONE - MUL_FIXED(inverse_t, inverse_t);
-        }
-        case EasingType::EASE_IN_OUT_QUAD:  
-            if (t < (FIXED_POINT_ONE / 2)) {
-                return MUL_FIXED(2 * t, t);
-            } else {
-                int32_t val = (FIXED_POINT_ONE * 2) - (2 * t);
-                return FIXED_POINT_ONE - MUL_FIXED(val, val) / 2;
-            }
-        case EasingType::EASE_IN_CUBIC:     return MUL_FIXED(MUL_FIXED(t, t), t);
-        case EasingType::EASE_OUT_CUBIC:    
-        {
-            int32_t inverse_t = FIXED_POINT_ONE - t;
-            return FIXED_POINT_ONE - MUL_FIXED(MUL_FIXED(inverse_t, inverse_t), inverse_t);
-        }
-        case EasingType::EASE_IN_OUT_CUBIC: 
-            if (t < (FIXED_POINT_ONE / 2)) {
-                return MUL_FIXED(4 * t, MUL_FIXED(t, t));
-            } else {
-                int32_t val = (FIXED_POINT_ONE * 2) - (2 * t);
-                return FIXED_POINT_ONE - MUL_FIXED(MUL_FIXED(val, val), val) / 2;
-            }
-        case EasingType::EASE_OUT_BOUNCE:   return easeOutBounce(t);
-        default:                            return t;
-    }
+#ifdef USE_EASING_LUT
+    return calculateLut(type, t);
+#else
+    return calculateExact(type, t);
+#endif
 }
 
 /**
- * @brief EaseOutBounce easing function, implemented with fixed-point numbers.
- * @param t Normalized time, fixed-point.
+ * @brief Table-driven easing, linear interpolation between neighbouring samples.
+ * @param type Easing type.
+ * @param t Normalized time, fixed-point, clamped to [0, 1].
  * @return Normalized progress, fixed-point.
  */
-int32_t EasingCalculator::easeOutBounce(int32_t t) {
-    // Use macros to simplify fixed-point operations
-    #define FIXED_DIV(a, b) ((int64_t)(a) * FIXED_POINT_ONE / (b))
-    #define FIXED_MUL(a, b) ((int64_t)(a) * (b) / FIXED_POINT_ONE)
+int32_t EasingCalculator::calculateLut(EasingType type, int32_t t)
+{
+    constexpr int FRAC_BITS = SHIFT_BITS - EASING_LUT_BITS;
 
-    const int32_t n1 = FLOAT_TO_FIXED(7.5625f);
-    const int32_t d1 = FLOAT_TO_FIXED(2.75f);
-    
-    if (t < FIXED_DIV(FIXED_POINT_ONE, d1)) 
-    {
-        return FIXED_MUL(n1, FIXED_MUL(t, t));
-    } 
-    else if (t < FIXED_DIV(FLOAT_TO_FIXED(2.0f), d1))
-    {
-        t -= FIXED_DIV(FLOAT_TO_FIXED(1.5f), d1);
-        return FIXED_MUL(n1, FIXED_MUL(t, t)) + FLOAT_TO_FIXED(0.75f);
-    }
-    else if (t < FIXED_DIV(FLOAT_TO_FIXED(2.5f), d1))
-    {
-        t -= FIXED_DIV(FLOAT_TO_FIXED(2.25f), d1);
-        return FIXED_MUL(n1, FIXED_MUL(t, t)) + FLOAT_TO_FIXED(0.9375f);
-    }
-    else 
-    {
-        t -= FIXED_DIV(FLOAT_TO_FIXED(2.625f), d1);
-        return FIXED_MUL(n1, FIXED_MUL(t, t)) + FLOAT_TO_FIXED(0.984375f);
-    }
+    if (type == EasingType::LINEAR) return t;
+    if (t <= 0) t = 0;
+
+    const int16_t* table = EASING_LUT.table[static_cast<int>(type) - 1];
+    if (t >= FIXED_POINT_ONE) return table[EASING_LUT_SIZE];
+
+    int32_t index = t >> FRAC_BITS;
+    int32_t frac = t & ((1 << FRAC_BITS) - 1);
+    int32_t a = table[index];
+    return a + (((table[index + 1] - a) * frac) >> FRAC_BITS);
 }
 
 /*
@@ -142,27 +148,1014 @@ bool Animation::update(uint32_t currentTime){
     return true;
 }
 
+/*
+@brief Stop the timeline if it is still playing, so the manager never sees a dangling pointer.
+*/
+Timeline::~Timeline() {
+    if (_manager) {
+        _manager->stop(*this);
+    }
+}
+
+/*
+@brief Remove all steps and hooks, stopping the timeline if it is playing.
+@return The timeline, for chaining.
+*/
+Timeline& Timeline::clear() {
+    if (_manager) {
+        _manager->stop(*this);
+    }
+    for (uint8_t i = 0; i < _stepCount; ++i) {
+        _steps[i] = Step{};
+    }
+    _stepCount = 0;
+    _started = 0;
+    _groupStart = 0;
+    _groupEnd = 0;
+    _duration = 0;
+    _onComplete = nullptr;
+    return *this;
+}
+
+/*
+@brief Append a step to the current group.
+@param offset Start of the step, milliseconds after the timeline starts.
+@param duration Duration of the step (milliseconds).
+@return The new step, or nullptr if the timeline is full.
+*/
+Timeline::Step* Timeline::appendStep(uint32_t offset, uint32_t duration) {
+    assert(_stepCount < MAX_TIMELINE_STEPS);
+    if (_stepCount >= MAX_TIMELINE_STEPS) {
+        return nullptr;
+    }
+    Step* step = &_steps[_stepCount++];
+    step->offset = offset;
+    step->duration = duration;
+    _groupEnd = std::max(_groupEnd, offset + duration);
+    _duration = std::max(_duration, _groupEnd);
+    return step;
+}
+
+/*
+@brief Add a tween to the current group.
+@param value The value to animate, it must outlive the timeline.
+@param targetValue The final value.
+@param duration Duration of the tween (milliseconds).
+@param easing Easing type.
+@param delay Delay after the start of the group (milliseconds).
+@return The timeline, for chaining.
+*/
+Timeline& Timeline::add(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing, uint32_t delay) {
+    Step* step = appendStep(_groupStart + delay, duration);
+    if (step) {
+        step->value = &value;
+        step->targetValue = targetValue;
+        step->easing = easing;
+    }
+    return *this;
+}
+
+/*
+@brief Add a hook to the current group, called once when it comes due.
+@param hook The function to call.
+@param delay Delay after the start of the group (milliseconds).
+@return The timeline, for chaining.
+*/
+Timeline& Timeline::call(std::function<void()> hook, uint32_t delay) {
+    Step* step = appendStep(_groupStart + delay, 0);
+    if (step) {
+        step->hook = std::move(hook);
+    }
+    return *this;
+}
+
+/*
+@brief Close the current group, steps added afterwards start once all of it has finished.
+@param gap Extra wait before the next group (milliseconds).
+@return The timeline, for chaining.
+*/
+Timeline& Timeline::then(uint32_t gap) {
+    _groupStart = _groupEnd + gap;
+    _groupEnd = _groupStart;
+    _duration = std::max(_duration, _groupStart);
+    return *this;
+}
+
+/*
+@brief Set the hook called after the last step has finished.
+@param hook The function to call.
+@return The timeline, for chaining.
+*/
+Timeline& Timeline::onComplete(std::function<void()> hook) {
+    _onComplete = std::move(hook);
+    return *this;
+}
+
+/*
+@brief Stop the animation if it is still running, so the manager does not write through dangling lanes.
+*/
+VecAnimationBase::~VecAnimationBase() {
+    if (_manager) {
+        _manager->stop(*this);
+    }
+}
+
+/*
+@brief Detach any timeline or multi-lane tween still running, so it does not stop itself on a dead manager later.
+*/
+AnimationManager::~AnimationManager() {
+    for (auto timeline : _timelines) {
+        if (timeline) {
+            timeline->_manager = nullptr;
+        }
+    }
+    for (auto animation : _vecAnimations) {
+        animation->_manager = nullptr;
+    }
+}
+
+/*
+@brief Start a pooled tween that drives an int32_t towards a target value.
+
+If a tween is already driving the same value it is retargeted in place: it
+restarts from the current value towards the new target and keeps its current
+velocity, instead of a second tween fighting over the value.
+@param value The value to animate, written on every update.
+@param targetValue The final value.
+@param duration Duration of the tween (milliseconds).
+@param easing Easing type.
+@param currentTime Current time (milliseconds), used as the start time.
+@param prot Protection status.
+@return Handle of the tween driving the value, invalid if the pool is exhausted.
+*/
+AnimationHandle AnimationManager::animate(int32_t& value, int32_t targetValue, uint32_t duration, EasingType easing,
+                                          uint32_t currentTime, PROTECTION prot) {
+    int32_t velocity = 0;
+    int index = findTweenByTarget(&value);
+    if (index >= 0) {
+        // If someone else wrote the value meanwhile, the tween's motion no longer applies
+        bool undisturbed = (value == _current[index]);
+
+        if (undisturbed && _endVal[index] == targetValue) {
+            // Already heading there, don't restart the curve
+            if (prot == PROTECTION::PROTECTED) _protected[index] = true;
+            return AnimationHandle{_id[index]};
+        }
+
+        velocity = undisturbed ? tweenVelocity(index, currentTime) : 0;
+        if (easingOf(index) != easing) {
+            // the pool is grouped by easing, move the tween over to its new group
+            uint16_t id = _id[index];
+            removeTween(index);
+            index = static_cast<int>(insertTween(easing));
+            _target[index] = &value;
+            _id[index] = id;
+        }
+    } else {
+        assert(_groupBegin[EASING_TYPE_COUNT] < MAX_ANIMATION_COUNT);
+        if (_groupBegin[EASING_TYPE_COUNT] >= MAX_ANIMATION_COUNT) {
+            return AnimationHandle{};
+        }
+
+        // a tween parked by a suspended scope is superseded by this one
+        dropSuspendedTween(&value);
+
+        // a spring driving the value hands its motion over to the tween
+        int spring = findSpringByTarget(&value);
+        if (spring >= 0) {
+            velocity = (value == _springCurrent[spring]) ? _springVel[spring] : 0;
+            removeSpring(spring);
+        }
+
+        index = static_cast<int>(insertTween(easing));
+        _target[index] = &value;
+        _id[index] = nextId();
+    }
+
+    _startVal[index] = value;
+    _endVal[index] = targetValue;
+    _current[index] = value;
+    _velocity[index] = velocity;
+    _startTime[index] = currentTime;
+    _duration[index] = duration;
+    _invDuration[index] = duration ? (1u << (SHIFT_BITS + 16)) / duration : 0;
+    _protected[index] = (prot == PROTECTION::PROTECTED);
+    _owner[index] = _scope;
+    return AnimationHandle{_id[index]};
+}
+
+/*
+@brief Start a pooled critically damped spring that pulls an int32_t towards a target value.
+
+Unlike a tween the spring has no fixed end time: calling spring() again on the
+same value only moves its target and keeps the current velocity, so the motion
+stays smooth however often it is interrupted. The spring leaves the pool as
+soon as it is at rest, so isRunning() reports when it has settled.
+@param value The value to animate, written on every update.
+@param targetValue The value to settle at.
+@param settleTime Time (milliseconds) the spring takes to settle from rest, 0 to jump.
+@param currentTime Current time (milliseconds).
+@param prot Protection status.
+@return Handle of the spring driving the value, invalid if it is already at rest or the pool is exhausted.
+*/
+AnimationHandle AnimationManager::spring(int32_t& value, int32_t targetValue, uint32_t settleTime, uint32_t currentTime,
+                                         PROTECTION prot) {
+    int32_t omega = settleTime ? std::max<int32_t>(SPRING_SETTLE_OMEGA_T / (int32_t)settleTime, 1) : 0;
+
+    int index = findSpringByTarget(&value);
+    if (index >= 0) {
+        if (value != _springCurrent[index]) {
+            // written by someone else meanwhile, start over from there
+            _springPos[index] = (int64_t)value << SHIFT_BITS;
+            _springVel[index] = 0;
+            _springCurrent[index] = value;
+        }
+        if (omega == 0) {
+            value = targetValue;
+            removeSpring(index);
+            return AnimationHandle{};
+        }
+        if (_springSuspended[index]) {
+            // picked up again, don't integrate over the time it was suspended
+            _springSuspended[index] = false;
+            _springTime[index] = currentTime;
+        }
+        _springGoal[index] = targetValue;
+        _springOmega[index] = omega;
+        _springOwner[index] = _scope;
+        if (prot == PROTECTION::PROTECTED) _springProtected[index] = true;
+        return AnimationHandle{_springId[index]};
+    }
+
+    // a tween driving the value hands its motion over to the spring
+    dropSuspendedTween(&value);
+    int32_t velocity = 0;
+    int tween = findTweenByTarget(&value);
+    if (tween >= 0) {
+        velocity = (value == _current[tween]) ? tweenVelocity(tween, currentTime) : 0;
+        removeTween(tween);
+    }
+
+    if (omega == 0 || (value == targetValue && velocity == 0)) {
+        value = targetValue;
+        return AnimationHandle{};
+    }
+
+    assert(_springCount < MAX_SPRING_COUNT);
+    if (_springCount >= MAX_SPRING_COUNT) {
+        return AnimationHandle{};
+    }
+
+    index = static_cast<int>(_springCount++);
+    _springTarget[index] = &value;
+    _springPos[index] = (int64_t)value << SHIFT_BITS;
+    _springVel[index] = velocity;
+    _springGoal[index] = targetValue;
+    _springOmega[index] = omega;
+    _springCurrent[index] = value;
+    _springTime[index] = currentTime;
+    _springProtected[index] = (prot == PROTECTION::PROTECTED);
+    _springId[index] = nextId();
+    _springOwner[index] = _scope;
+    _springSuspended[index] = false;
+    return AnimationHandle{_springId[index]};
+}
+
+/*
+@brief Stop a pooled tween or spring, leaving its value where it currently is.
+@param handle Handle returned by animate() or spring().
+*/
+void AnimationManager::stop(AnimationHandle handle) {
+    int index = findTween(handle);
+    if (index >= 0) {
+        removeTween(index);
+        return;
+    }
+    index = findSpring(handle);
+    if (index >= 0) {
+        removeSpring(index);
+        return;
+    }
+    index = findSuspendedTween(handle);
+    if (index >= 0) {
+        _suspendedTweens.erase(_suspendedTweens.begin() + index);
+    }
+}
+
+/*
+@brief Check whether a pooled tween or spring is still running.
+@param handle Handle returned by animate() or spring().
+@return True if the tween has not finished or the spring has not settled yet, suspended or not.
+*/
+bool AnimationManager::isRunning(AnimationHandle handle) const {
+    return findTween(handle) >= 0 || findSpring(handle) >= 0 || findSuspendedTween(handle) >= 0;
+}
+
+/*
+@brief Hand out the id of a new tween or spring.
+@return Id, never 0.
+*/
+uint16_t AnimationManager::nextId() {
+    uint16_t id = _nextId++;
+    if (_nextId == 0) _nextId = 1; // 0 is reserved for invalid handles
+    return id;
+}
+
+/*
+@brief Find the pool index of a tween.
+@param handle Handle returned by animate().
+@return Index into the pool, or -1 if the tween is gone.
+*/
+int AnimationManager::findTween(AnimationHandle handle) const {
+    if (!handle.isValid()) {
+        return -1;
+    }
+    for (size_t i = 0; i < _groupBegin[EASING_TYPE_COUNT]; ++i) {
+        if (_id[i] == handle.id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/*
+@brief Find the pool index of the tween driving a value.
+@param target Address of the animated value.
+@return Index into the pool, or -1 if the value is not animated.
+*/
+int AnimationManager::findTweenByTarget(const int32_t* target) const {
+    for (size_t i = 0; i < _groupBegin[EASING_TYPE_COUNT]; ++i) {
+        if (_target[i] == target) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/*
+@brief Find the pool index of a spring.
+@param handle Handle returned by spring().
+@return Index into the spring pool, or -1 if the spring is gone.
+*/
+int AnimationManager::findSpring(AnimationHandle handle) const {
+    if (!handle.isValid()) {
+        return -1;
+    }
+    for (size_t i = 0; i < _springCount; ++i) {
+        if (_springId[i] == handle.id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/*
+@brief Find the pool index of the spring driving a value.
+@param target Address of the animated value.
+@return Index into the spring pool, or -1 if no spring drives the value.
+*/
+int AnimationManager::findSpringByTarget(const int32_t* target) const {
+    for (size_t i = 0; i < _springCount; ++i) {
+        if (_springTarget[i] == target) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/*
+@brief Remove a spring from the pool, keeping the order of the others.
+@param index Index into the spring pool.
+*/
+void AnimationManager::removeSpring(size_t index) {
+    for (size_t i = index + 1; i < _springCount; ++i) {
+        moveSpring(i, i - 1);
+    }
+    --_springCount;
+}
+
+/*
+@brief Copy a spring from one pool slot to another.
+@param from Source index.
+@param to Destination index.
+*/
+void AnimationManager::moveSpring(size_t from, size_t to) {
+    _springTarget[to] = _springTarget[from];
+    _springPos[to] = _springPos[from];
+    _springVel[to] = _springVel[from];
+    _springGoal[to] = _springGoal[from];
+    _springOmega[to] = _springOmega[from];
+    _springCurrent[to] = _springCurrent[from];
+    _springTime[to] = _springTime[from];
+    _springProtected[to] = _springProtected[from];
+    _springId[to] = _springId[from];
+    _springOwner[to] = _springOwner[from];
+    _springSuspended[to] = _springSuspended[from];
+}
+
+/*
+@brief Easing type of a pooled tween, given by the group it lives in.
+@param index Index into the pool.
+@return Easing type of the tween.
+*/
+EasingType AnimationManager::easingOf(size_t index) const {
+    int group = 0;
+    while (index >= _groupBegin[group + 1]) {
+        ++group;
+    }
+    return static_cast<EasingType>(group);
+}
+
+/*
+@brief Reserve a slot at the end of an easing group.
+
+Every later group hands its first slot over to its end, which shifts the
+free slot down to the requested group in one move per group.
+@param easing Group to insert into.
+@return Index of the new slot, its fields are left for the caller to fill.
+*/
+size_t AnimationManager::insertTween(EasingType easing) {
+    const int group = static_cast<int>(easing);
+    size_t hole = _groupBegin[EASING_TYPE_COUNT]++;
+    for (int g = EASING_TYPE_COUNT - 1; g > group; --g) {
+        size_t first = _groupBegin[g];
+        if (first != hole) {
+            moveTween(first, hole);
+        }
+        hole = first;
+        ++_groupBegin[g];
+    }
+    return hole;
+}
+
+/*
+@brief Remove a slot from the pool, the reverse of insertTween().
+@param index Index into the pool.
+*/
+void AnimationManager::removeTween(size_t index) {
+    const int group = static_cast<int>(easingOf(index));
+    size_t hole = index;
+    for (int g = group; g < EASING_TYPE_COUNT; ++g) {
+        size_t last = _groupBegin[g + 1] - 1;
+        if (last != hole) {
+            moveTween(last, hole);
+        }
+        hole = last;
+        if (g > group) --_groupBegin[g];
+    }
+    --_groupBegin[EASING_TYPE_COUNT];
+}
+
+/*
+@brief Copy a tween from one pool slot to another.
+@param from Source index.
+@param to Destination index.
+*/
+void AnimationManager::moveTween(size_t from, size_t to) {
+    _target[to] = _target[from];
+    _startVal[to] = _startVal[from];
+    _endVal[to] = _endVal[from];
+    _current[to] = _current[from];
+    _velocity[to] = _velocity[from];
+    _startTime[to] = _startTime[from];
+    _duration[to] = _duration[from];
+    _invDuration[to] = _invDuration[from];
+    _protected[to] = _protected[from];
+    _id[to] = _id[from];
+    _owner[to] = _owner[from];
+}
+
+/*
+@brief Drop tweens from the pool, keeping the order of the rest.
+@param keep Per slot flag, slots with false are dropped.
+*/
+void AnimationManager::compactTweens(const bool* keep) {
+    size_t writeIndex = 0;
+    for (int g = 0; g < EASING_TYPE_COUNT; ++g) {
+        size_t begin = _groupBegin[g];
+        size_t end = _groupBegin[g + 1];
+        _groupBegin[g] = writeIndex;
+        for (size_t readIndex = begin; readIndex < end; ++readIndex) {
+            if (keep[readIndex]) {
+                if (writeIndex != readIndex) {
+                    moveTween(readIndex, writeIndex);
+                }
+                ++writeIndex;
+            }
+        }
+    }
+    _groupBegin[EASING_TYPE_COUNT] = writeIndex;
+}
+
+/*
+@brief Normalized time of a tween.
+
+Multiplies by a precomputed reciprocal of the duration instead of dividing,
+which keeps the batch loop free of divisions. Clamping elapsed to the
+duration bounds the product by 1 << (SHIFT_BITS + 16).
+@param elapsed Time since the tween started (milliseconds).
+@param duration Duration of the tween (milliseconds).
+@param invDuration Reciprocal of the duration, see AnimationManager::_invDuration.
+@return Normalized time, fixed-point, 1.0 once the tween is complete.
+*/
+static inline int32_t tweenTime(uint32_t elapsed, uint32_t duration, uint32_t invDuration) {
+    uint32_t clamped = elapsed < duration ? elapsed : duration;
+    return elapsed < duration ? static_cast<int32_t>((clamped * invDuration) >> 16) : FIXED_POINT_ONE;
+}
+
+/*
+@brief Offset of a tween from its start value at a normalized time.
+
+The eased distance is topped up with a momentum term v0 * D * t(1-t)^2, the
+Hermite basis that starts with slope v0 and fades out to zero by the end, so
+a retargeted tween leaves with the velocity it had and still lands exactly.
+@param delta Distance of the tween, endVal - startVal.
+@param velocity Velocity carried over from a retarget, fixed-point units per ms.
+@param duration Duration of the tween (milliseconds).
+@param t Normalized time, fixed-point.
+@param progress Eased progress at t, fixed-point.
+@return Offset from startVal, fixed-point.
+*/
+static inline int64_t tweenOffsetAt(int32_t delta, int32_t velocity, uint32_t duration, int32_t t, int32_t progress) {
+    int32_t inverse_t = FIXED_POINT_ONE - t;
+    int64_t hermite = MUL_FIXED(MUL_FIXED(t, inverse_t), inverse_t);
+    return (int64_t)delta * progress + (((int64_t)velocity * duration * hermite) >> SHIFT_BITS);
+}
+
+/*
+@brief Evaluate one easing curve over a run of tweens.
+@param t Normalized times, fixed-point.
+@param progress Output, eased progress, fixed-point.
+@param count Number of tweens.
+*/
+template <EasingType Easing>
+static void easeBatch(const int32_t* t, int32_t* progress, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+#ifdef USE_EASING_LUT
+        progress[i] = EasingCalculator::calculateLut(Easing, t[i]);
+#else
+        progress[i] = EasingCalculator::calculateExact(Easing, t[i]);
+#endif
+    }
+}
+
+/*
+@brief Dispatch a run of tweens to the loop of their easing curve.
+@param easing Easing type shared by the run.
+@param t Normalized times, fixed-point.
+@param progress Output, eased progress, fixed-point.
+@param count Number of tweens.
+*/
+static void easeBatch(EasingType easing, const int32_t* t, int32_t* progress, size_t count) {
+    switch (easing)
+    {
+        case EasingType::LINEAR:            easeBatch<EasingType::LINEAR>(t, progress, count); break;
+        case EasingType::EASE_IN_QUAD:      easeBatch<EasingType::EASE_IN_QUAD>(t, progress, count); break;
+        case EasingType::EASE_OUT_QUAD:     easeBatch<EasingType::EASE_OUT_QUAD>(t, progress, count); break;
+        case EasingType::EASE_IN_OUT_QUAD:  easeBatch<EasingType::EASE_IN_OUT_QUAD>(t, progress, count); break;
+        case EasingType::EASE_IN_CUBIC:     easeBatch<EasingType::EASE_IN_CUBIC>(t, progress, count); break;
+        case EasingType::EASE_OUT_CUBIC:    easeBatch<EasingType::EASE_OUT_CUBIC>(t, progress, count); break;
+        case EasingType::EASE_IN_OUT_CUBIC: easeBatch<EasingType::EASE_IN_OUT_CUBIC>(t, progress, count); break;
+        case EasingType::EASE_OUT_BOUNCE:   easeBatch<EasingType::EASE_OUT_BOUNCE>(t, progress, count); break;
+        default:                            easeBatch<EasingType::LINEAR>(t, progress, count); break;
+    }
+}
+
+/*
+@brief Offset of a pooled tween from its start value after some elapsed time.
+@param index Index into the pool.
+@param elapsed Time since the tween started (milliseconds).
+@return Offset from startVal, fixed-point.
+*/
+int64_t AnimationManager::tweenOffset(size_t index, uint32_t elapsed) const {
+    int32_t delta = _endVal[index] - _startVal[index];
+    if (elapsed >= _duration[index]) {
+        return (int64_t)delta * FIXED_POINT_ONE;
+    }
+
+    int32_t t = tweenTime(elapsed, _duration[index], _invDuration[index]);
+    int32_t progress = EasingCalculator::calculate(easingOf(index), t);
+    return tweenOffsetAt(delta, _velocity[index], _duration[index], t, progress);
+}
+
+/*
+@brief Sample the current velocity of a pooled tween.
+@param index Index into the pool.
+@param currentTime Current time (milliseconds).
+@return Velocity in fixed-point units per millisecond.
+*/
+int32_t AnimationManager::tweenVelocity(size_t index, uint32_t currentTime) const {
+    uint32_t elapsed = currentTime - _startTime[index];
+    if (elapsed == 0) {
+        return _velocity[index];
+    }
+    if (elapsed >= _duration[index]) {
+        return 0;
+    }
+    uint32_t window = elapsed < VELOCITY_SAMPLE_MS ? elapsed : VELOCITY_SAMPLE_MS;
+    int64_t velocity = (tweenOffset(index, elapsed) - tweenOffset(index, elapsed - window)) / window;
+    return std::clamp<int64_t>(velocity, INT32_MIN, INT32_MAX);
+}
+
+/*
+@brief e^-x in fixed-point, accurate to about one LSB.
+@param x Exponent, fixed-point, not negative.
+@return e^-x, fixed-point.
+*/
+static int32_t expNegFixed(int64_t x) {
+    // e^-x = 2^-(x / ln 2), split into a whole shift and a fraction
+    int64_t z = MUL_FIXED(x, FLOAT_TO_FIXED(1.442695f));
+    if (z >= ((int64_t)SHIFT_BITS + 1) << SHIFT_BITS) {
+        return 0;
+    }
+    int32_t shift = (int32_t)(z >> SHIFT_BITS);
+    int32_t f = (int32_t)(z & (FIXED_POINT_ONE - 1));
+    // 2^-f ~ 1 - f * (ln2 - f * (0.2402 - f * 0.0471)), exact at f = 0 and f = 1
+    int32_t p = 193;
+    p = 984 - (int32_t)MUL_FIXED(f, p);
+    p = 2839 - (int32_t)MUL_FIXED(f, p);
+    p = FIXED_POINT_ONE - (int32_t)MUL_FIXED(f, p);
+    return p >> shift;
+}
+
+/*
+@brief Advance all pooled springs to the current time and write their values.
+
+Each step is the exact solution of the critically damped spring over the
+elapsed time, so the motion does not depend on the frame rate. Springs that
+came to rest snap onto their target and leave the pool.
+@param currentTime Current time (milliseconds).
+*/
+void AnimationManager::updateSprings(uint32_t currentTime) {
+    size_t write = 0;
+    for (size_t i = 0; i < _springCount; ++i) {
+        if (_springSuspended[i]) {
+            if (write != i) moveSpring(i, write);
+            ++write;
+            continue;
+        }
+
+        if (*_springTarget[i] != _springCurrent[i]) {
+            // written by someone else meanwhile, continue from there
+            _springPos[i] = (int64_t)*_springTarget[i] << SHIFT_BITS;
+            _springVel[i] = 0;
+        }
+
+        // a long stall is treated like one second, the spring has settled by then anyway
+        int64_t h = std::min<uint32_t>(currentTime - _springTime[i], 1000);
+        int64_t omega = _springOmega[i];
+        int64_t x = _springPos[i] - ((int64_t)_springGoal[i] << SHIFT_BITS);
+        int64_t v = _springVel[i];
+
+        // x(t) = (x0 + (v0 + w x0) t) e^-wt, v(t) = (v0 - w (v0 + w x0) t) e^-wt
+        int64_t wt = omega * h;
+        int64_t a = v + MUL_FIXED(omega, x);
+        int64_t e = expNegFixed(wt);
+        x = MUL_FIXED(x + a * h, e);
+        v = MUL_FIXED(v - MUL_FIXED(wt, a), e);
+
+        bool atRest = std::abs(x) < SPRING_REST_THRESHOLD && std::abs(v) * VELOCITY_SAMPLE_MS < SPRING_REST_THRESHOLD;
+        if (atRest) {
+            _changed |= *_springTarget[i] != _springGoal[i];
+            *_springTarget[i] = _springGoal[i];
+            continue;
+        }
+
+        _springPos[i] = x + ((int64_t)_springGoal[i] << SHIFT_BITS);
+        _springVel[i] = (int32_t)std::clamp<int64_t>(v, INT32_MIN, INT32_MAX);
+        _springTime[i] = currentTime;
+        _springCurrent[i] = (int32_t)((_springPos[i] + FIXED_POINT_ONE / 2) >> SHIFT_BITS);
+        _changed |= *_springTarget[i] != _springCurrent[i];
+        *_springTarget[i] = _springCurrent[i];
+
+        if (write != i) moveSpring(i, write);
+        ++write;
+    }
+    _springCount = write;
+}
+
+/*
+@brief Start a multi-lane tween, driving every lane of the animation towards its target along one curve.
+
+If the animation is already running it is retargeted: every lane restarts from
+its current value and keeps its velocity. A lane that is currently driven by a
+pooled tween or spring takes over that motion the same way.
+@param animation The animation, it must stay alive until it finishes or is stopped.
+@param targetValues One final value per lane.
+@param duration Duration of the tween (milliseconds).
+@param easing Easing type.
+@param currentTime Current time (milliseconds), used as the start time.
+@param prot Protection status.
+*/
+void AnimationManager::animate(VecAnimationBase& animation, const int32_t* targetValues, uint32_t duration,
+                               EasingType easing, uint32_t currentTime, PROTECTION prot) {
+    bool running = animation._manager == this;
+    if (running && animation._suspended) {
+        // picked up again, continue where it was suspended
+        animation._startTime += currentTime - animation._suspendedAt;
+        animation._suspended = false;
+    }
+    uint32_t elapsed = currentTime - animation._startTime;
+
+    if (running) {
+        bool sameTargets = true;
+        for (uint8_t i = 0; i < animation._laneCount; ++i) {
+            const VecAnimationBase::Lane& lane = animation._lanes[i];
+            sameTargets = sameTargets && lane.endVal == targetValues[i] && *lane.value == lane.current;
+        }
+        if (sameTargets) {
+            // Already heading there, don't restart the curve
+            if (prot == PROTECTION::PROTECTED) animation._prot = prot;
+            animation._owner = _scope;
+            return;
+        }
+    } else {
+        if (animation._manager) {
+            animation._manager->stop(animation);
+        }
+        assert(!_vecAnimations.full());
+        if (_vecAnimations.full()) {
+            return;
+        }
+    }
+
+    // the easing is shared by every lane, so velocities are sampled from one pair of curve points
+    int32_t t = 0, progress = 0, tPrev = 0, progressPrev = 0;
+    uint32_t window = elapsed < VELOCITY_SAMPLE_MS ? elapsed : VELOCITY_SAMPLE_MS;
+    bool sample = running && window > 0 && elapsed < animation._duration;
+    if (sample) {
+        t = tweenTime(elapsed, animation._duration, animation._invDuration);
+        progress = EasingCalculator::calculate(animation._easing, t);
+        tPrev = tweenTime(elapsed - window, animation._duration, animation._invDuration);
+        progressPrev = EasingCalculator::calculate(animation._easing, tPrev);
+    }
+
+    for (uint8_t i = 0; i < animation._laneCount; ++i) {
+        VecAnimationBase::Lane& lane = animation._lanes[i];
+        int32_t velocity = 0;
+        if (running) {
+            if (*lane.value == lane.current) {
+                if (sample) {
+                    int32_t delta = lane.endVal - lane.startVal;
+                    int64_t offset = tweenOffsetAt(delta, lane.velocity, animation._duration, t, progress);
+                    int64_t offsetPrev = tweenOffsetAt(delta, lane.velocity, animation._duration, tPrev, progressPrev);
+                    velocity = (int32_t)std::clamp<int64_t>((offset - offsetPrev) / window, INT32_MIN, INT32_MAX);
+                } else if (elapsed == 0) {
+                    velocity = lane.velocity;
+                }
+            }
+        } else {
+            dropSuspendedTween(lane.value);
+            int tween = findTweenByTarget(lane.value);
+            if (tween >= 0) {
+                velocity = (*lane.value == _current[tween]) ? tweenVelocity(tween, currentTime) : 0;
+                removeTween(tween);
+            }
+            int spring = findSpringByTarget(lane.value);
+            if (spring >= 0) {
+                velocity = (*lane.value == _springCurrent[spring]) ? _springVel[spring] : 0;
+                removeSpring(spring);
+            }
+        }
+
+        lane.startVal = *lane.value;
+        lane.endVal = targetValues[i];
+        lane.current = *lane.value;
+        lane.velocity = velocity;
+    }
+
+    animation._easing = easing;
+    animation._startTime = currentTime;
+    animation._duration = duration;
+    animation._invDuration = duration ? (1u << (SHIFT_BITS + 16)) / duration : 0;
+    animation._prot = prot;
+    animation._owner = _scope;
+    if (!running) {
+        animation._manager = this;
+        _vecAnimations.push_back(&animation);
+    }
+}
+
+/*
+@brief Stop a multi-lane tween, leaving every lane where it currently is.
+@param animation The animation to stop.
+*/
+void AnimationManager::stop(VecAnimationBase& animation) {
+    _vecAnimations.erase(std::remove(_vecAnimations.begin(), _vecAnimations.end(), &animation), _vecAnimations.end());
+    animation._manager = nullptr;
+}
+
+/*
+@brief Advance all multi-lane tweens, evaluating the easing once per animation.
+@param currentTime Current time (milliseconds).
+*/
+void AnimationManager::updateVecAnimations(uint32_t currentTime) {
+    auto writePos = _vecAnimations.begin();
+    for (VecAnimationBase* animation : _vecAnimations) {
+        if (animation->_suspended) {
+            *writePos++ = animation;
+            continue;
+        }
+
+        uint32_t elapsed = currentTime - animation->_startTime;
+        bool running = elapsed < animation->_duration;
+        int32_t t = tweenTime(elapsed, animation->_duration, animation->_invDuration);
+        int32_t progress = EasingCalculator::calculate(animation->_easing, t);
+
+        for (uint8_t i = 0; i < animation->_laneCount; ++i) {
+            VecAnimationBase::Lane& lane = animation->_lanes[i];
+            int64_t offset = tweenOffsetAt(lane.endVal - lane.startVal, lane.velocity, animation->_duration, t, progress);
+            lane.current = running ? lane.startVal + (int32_t)(offset / FIXED_POINT_ONE) : lane.endVal;
+            _changed |= *lane.value != lane.current;
+            *lane.value = lane.current;
+        }
+
+        if (running) {
+            *writePos++ = animation;
+        } else {
+            animation->_manager = nullptr;
+        }
+    }
+    _vecAnimations.erase(writePos, _vecAnimations.end());
+}
+
 /*
 @brief Add a new animation to the manager.
-@param animation Shared pointer to the Animation object to be added.
+@param animation Shared pointer to the Animation object to be added, dropped if MAX_CUSTOM_ANIMATION_COUNT are running.
 */
 void AnimationManager::addAnimation(std::shared_ptr<Animation> animation) {
-    assert(_animations.size() < _animations.max_size());
-    if (!animation) {
+    assert(!_animations.full());
+    if (!animation || _animations.full()) {
         return;
     }
     _animations.push_back(animation);
 }
 
+/*
+@brief Start playing a timeline, restarting it if it is already playing.
+@param timeline The timeline to play, it must stay alive until it finishes or is stopped.
+@param currentTime Current time (milliseconds), used as the start time.
+@param prot Protection status, applied to the timeline and every tween it starts.
+*/
+void AnimationManager::play(Timeline& timeline, uint32_t currentTime, PROTECTION prot) {
+    stop(timeline);
+
+    auto slot = std::find(_timelines.begin(), _timelines.end(), nullptr);
+    if (slot == _timelines.end()) {
+        assert(_timelines.size() < _timelines.max_size());
+        if (_timelines.full()) {
+            return;
+        }
+        _timelines.push_back(nullptr);
+        slot = _timelines.end() - 1;
+    }
+
+    timeline._started = 0;
+    timeline._startTime = currentTime;
+    timeline._prot = prot;
+    timeline._suspended = false;
+    timeline._owner = _scope;
+    timeline._manager = this;
+    *slot = &timeline;
+}
+
+/*
+@brief Stop a timeline along with the tweens it has started, leaving their values where they are.
+@param timeline The timeline to stop.
+*/
+void AnimationManager::stop(Timeline& timeline) {
+    if (timeline._manager == this) {
+        for (uint8_t s = 0; s < timeline._stepCount; ++s) {
+            const Timeline::Step& step = timeline._steps[s];
+            if ((timeline._started & (1u << s)) && step.tween.isValid()) {
+                stop(step.tween);
+            }
+        }
+    }
+    for (auto& entry : _timelines) {
+        if (entry == &timeline) {
+            entry = nullptr;
+        }
+    }
+    timeline._manager = nullptr;
+}
+
+/*
+@brief Start every timeline step that has come due and finish completed timelines.
+
+Tweens are started at the time their step was scheduled rather than at the
+current time, so a late update does not shift the rest of the timeline.
+@param currentTime Current time (milliseconds).
+*/
+void AnimationManager::updateTimelines(uint32_t currentTime) {
+    AnimationScope scope = _scope;
+    for (size_t i = 0; i < _timelines.size(); ++i) {
+        Timeline* timeline = _timelines[i];
+        if (!timeline || timeline->_suspended) {
+            continue;
+        }
+
+        // tweens and hooks run on behalf of the scope that played the timeline
+        _scope = timeline->_owner;
+
+        uint32_t elapsed = currentTime - timeline->_startTime;
+        for (uint8_t s = 0; s < timeline->_stepCount && _timelines[i] == timeline; ++s) {
+            Timeline::Step& step = timeline->_steps[s];
+            if ((timeline->_started & (1u << s)) || step.offset > elapsed) {
+                continue;
+            }
+            timeline->_started |= (1u << s);
+
+            if (step.value) {
+                step.tween = animate(*step.value, step.targetValue, step.duration, step.easing,
+                                     timeline->_startTime + step.offset, timeline->_prot);
+            } else if (step.hook) {
+                // the hook may stop the timeline, checked by the loop condition
+                step.hook();
+                _changed = true;
+            }
+        }
+        if (_timelines[i] != timeline) {
+            continue;
+        }
+
+        uint32_t allStarted = (timeline->_stepCount >= 32) ? UINT32_MAX : ((1u << timeline->_stepCount) - 1);
+        if (timeline->_started == allStarted && elapsed >= timeline->_duration) {
+            _timelines[i] = nullptr;
+            timeline->_manager = nullptr;
+            if (timeline->_onComplete) {
+                timeline->_onComplete();
+                _changed = true;
+            }
+        }
+    }
+
+    _scope = scope;
+
+    _timelines.erase(std::remove(_timelines.begin(), _timelines.end(), nullptr), _timelines.end());
+}
+
 /*
 @brief Update all active animations based on the current time.
 @param currentTime Current time (milliseconds).
+@return true if anything a frame could show changed.
 */
-void AnimationManager::update(uint32_t currentTime) {
+bool AnimationManager::update(uint32_t currentTime) {
+    _changed = false;
+
+    // timelines first, so tweens they start are evaluated on this update already
+    if (!_timelines.empty()) {
+        updateTimelines(currentTime);
+    }
+
+    const size_t count = _groupBegin[EASING_TYPE_COUNT];
+    int32_t t[MAX_ANIMATION_COUNT];
+    int32_t progress[MAX_ANIMATION_COUNT];
+    bool running[MAX_ANIMATION_COUNT];
+
+    // pooled tweens, one pass per stage so every loop stays branch-free
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t elapsed = currentTime - _startTime[i];
+        running[i] = elapsed < _duration[i];
+        t[i] = tweenTime(elapsed, _duration[i], _invDuration[i]);
+    }
+
+    for (int g = 0; g < EASING_TYPE_COUNT; ++g) {
+        size_t begin = _groupBegin[g];
+        size_t end = _groupBegin[g + 1];
+        if (begin != end) {
+            easeBatch(static_cast<EasingType>(g), t + begin, progress + begin, end - begin);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        int64_t offset = tweenOffsetAt(_endVal[i] - _startVal[i], _velocity[i], _duration[i], t[i], progress[i]);
+        // land exactly on the target, the easing curves can be a LSB short at t = 1
+        _current[i] = running[i] ? _startVal[i] + (int32_t)(offset / FIXED_POINT_ONE) : _endVal[i];
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        _changed |= *_target[i] != _current[i];
+        *_target[i] = _current[i];
+    }
+
+    // finished tweens leave the pool, insertion order is kept within each group
+    compactTweens(running);
+
+    if (!_vecAnimations.empty()) {
+        updateVecAnimations(currentTime);
+    }
+
+    if (_springCount) {
+        updateSprings(currentTime);
+    }
+
     if (_animations.empty()) {
-        return;
+        return _changed;
     }
 
+    // custom animations write arbitrary state, assume they changed it
+    _changed = true;
     auto writePos = _animations.begin();
     for (auto readPos = _animations.begin(); readPos != _animations.end(); ++readPos) {
         if ((*readPos)->update(currentTime)) {
@@ -179,13 +1172,27 @@ void AnimationManager::update(uint32_t currentTime) {
         }
     }
     _animations.erase(writePos, _animations.end());
+    return _changed;
 }
 
 /*
 @brief clear all animations in the manager.
 */
 void AnimationManager::clear(){
+    std::fill(std::begin(_groupBegin), std::end(_groupBegin), 0);
+    _suspendedTweens.clear();
+    _springCount = 0;
     _animations.clear();
+    for (auto animation : _vecAnimations) {
+        animation->_manager = nullptr;
+    }
+    _vecAnimations.clear();
+    for (auto& timeline : _timelines) {
+        if (timeline) {
+            timeline->_manager = nullptr;
+            timeline = nullptr;
+        }
+    }
 }
 
 /*
@@ -198,10 +1205,59 @@ void AnimationManager::markProtected(std::shared_ptr<Animation> animation) {
     }
 }
 
+/*
+@brief mark a pooled tween or spring as protected, preventing it from being cleared.
+@param handle handle of the tween or spring to be marked as protected.
+*/
+void AnimationManager::markProtected(AnimationHandle handle) {
+    int index = findTween(handle);
+    if (index >= 0) {
+        _protected[index] = true;
+        return;
+    }
+    index = findSpring(handle);
+    if (index >= 0) {
+        _springProtected[index] = true;
+        return;
+    }
+    index = findSuspendedTween(handle);
+    if (index >= 0) {
+        _suspendedTweens[index].prot = true;
+    }
+}
+
 /*
 @brief clean all unprotected animations in the manager.
 */
 void AnimationManager::clearUnprotected() {
+    compactTweens(_protected);
+    _suspendedTweens.erase(std::remove_if(_suspendedTweens.begin(), _suspendedTweens.end(),
+                                          [](const SuspendedTween& tween) { return !tween.prot; }),
+                           _suspendedTweens.end());
+
+    for (size_t i = _springCount; i-- > 0;) {
+        if (!_springProtected[i]) {
+            removeSpring(i);
+        }
+    }
+
+    auto vecWritePos = _vecAnimations.begin();
+    for (VecAnimationBase* animation : _vecAnimations) {
+        if (animation->_prot == PROTECTION::PROTECTED) {
+            *vecWritePos++ = animation;
+        } else {
+            animation->_manager = nullptr;
+        }
+    }
+    _vecAnimations.erase(vecWritePos, _vecAnimations.end());
+
+    for (auto& timeline : _timelines) {
+        if (timeline && timeline->_prot != PROTECTION::PROTECTED) {
+            timeline->_manager = nullptr;
+            timeline = nullptr;
+        }
+    }
+
     if (_animations.empty()) {
         return;
     }
@@ -222,15 +1278,207 @@ void AnimationManager::clearUnprotected() {
 @brief clean all protection marks from all animations.
 */
 void AnimationManager::clearAllProtectionMarks() {
+    std::fill(_protected, _protected + _groupBegin[EASING_TYPE_COUNT], false);
+    std::fill(_springProtected, _springProtected + _springCount, false);
+    for (auto& tween : _suspendedTweens) {
+        tween.prot = false;
+    }
+    for (auto animation : _vecAnimations) {
+        animation->_prot = PROTECTION::NOT_PROTECTED;
+    }
+    for (auto timeline : _timelines) {
+        if (timeline) {
+            timeline->_prot = PROTECTION::NOT_PROTECTED;
+        }
+    }
     for (const auto& anim_ : _animations) {
         anim_->setProtected(false);
     }
 }
 
 /*
-@brief acquire number of current active count
+@brief acquire number of current active count, animations of suspended scopes are not counted
 @return (size_t) number of current active count
 */
 size_t AnimationManager::activeCount() const {
-    return _animations.size();
+    size_t timelines = std::count_if(_timelines.begin(), _timelines.end(), [](const Timeline* timeline) { return timeline && !timeline->_suspended; });
+    size_t springs = std::count(_springSuspended, _springSuspended + _springCount, false);
+    size_t vecAnimations = std::count_if(_vecAnimations.begin(), _vecAnimations.end(), [](const VecAnimationBase* animation) { return !animation->_suspended; });
+    return _groupBegin[EASING_TYPE_COUNT] + springs + vecAnimations + _animations.size() + timelines;
+}
+
+/*
+@brief Set the scope that animations started from now on belong to.
+@param scope The new scope, nullptr for the global scope.
+@return The previous scope, for restoring it afterwards.
+*/
+AnimationScope AnimationManager::setScope(AnimationScope scope) {
+    AnimationScope previous = _scope;
+    _scope = scope;
+    return previous;
+}
+
+/*
+@brief Freeze every animation of a scope where it is.
+
+Pooled tweens are parked outside the pool and springs, multi-lane tweens and
+timelines are skipped, so a suspended scope costs nothing per update and does
+not keep the display busy. Custom Animation objects are not scoped.
+@param scope The scope to suspend.
+@param currentTime Current time (milliseconds).
+*/
+void AnimationManager::suspend(AnimationScope scope, uint32_t currentTime) {
+    bool keep[MAX_ANIMATION_COUNT];
+    for (size_t i = 0; i < _groupBegin[EASING_TYPE_COUNT]; ++i) {
+        keep[i] = _owner[i] != scope;
+        if (keep[i]) {
+            continue;
+        }
+        assert(!_suspendedTweens.full());
+        if (_suspendedTweens.full()) {
+            // no room to park it, let it finish instead
+            keep[i] = true;
+            continue;
+        }
+        _suspendedTweens.push_back(SuspendedTween{_target[i], _startVal[i], _endVal[i], _current[i], _velocity[i],
+                                                  currentTime - _startTime[i], _duration[i], _invDuration[i],
+                                                  _owner[i], _id[i], easingOf(i), _protected[i]});
+    }
+    compactTweens(keep);
+
+    for (size_t i = 0; i < _springCount; ++i) {
+        if (_springOwner[i] == scope) {
+            _springSuspended[i] = true;
+        }
+    }
+    for (auto animation : _vecAnimations) {
+        if (animation->_owner == scope && !animation->_suspended) {
+            animation->_suspended = true;
+            animation->_suspendedAt = currentTime;
+        }
+    }
+    for (auto timeline : _timelines) {
+        if (timeline && timeline->_owner == scope && !timeline->_suspended) {
+            timeline->_suspended = true;
+            timeline->_suspendedAt = currentTime;
+        }
+    }
+}
+
+/*
+@brief Continue the animations of a suspended scope from where they were frozen.
+@param scope The scope to resume.
+@param currentTime Current time (milliseconds).
+*/
+void AnimationManager::resume(AnimationScope scope, uint32_t currentTime) {
+    auto writePos = _suspendedTweens.begin();
+    for (auto& tween : _suspendedTweens) {
+        if (tween.owner != scope || _groupBegin[EASING_TYPE_COUNT] >= MAX_ANIMATION_COUNT) {
+            *writePos++ = tween;
+            continue;
+        }
+        size_t index = insertTween(tween.easing);
+        _target[index] = tween.target;
+        _startVal[index] = tween.startVal;
+        _endVal[index] = tween.endVal;
+        _current[index] = tween.current;
+        _velocity[index] = tween.velocity;
+        _startTime[index] = currentTime - tween.elapsed;
+        _duration[index] = tween.duration;
+        _invDuration[index] = tween.invDuration;
+        _protected[index] = tween.prot;
+        _id[index] = tween.id;
+        _owner[index] = tween.owner;
+    }
+    _suspendedTweens.erase(writePos, _suspendedTweens.end());
+
+    for (size_t i = 0; i < _springCount; ++i) {
+        if (_springOwner[i] == scope && _springSuspended[i]) {
+            _springSuspended[i] = false;
+            _springTime[i] = currentTime;
+        }
+    }
+    for (auto animation : _vecAnimations) {
+        if (animation->_owner == scope && animation->_suspended) {
+            animation->_suspended = false;
+            animation->_startTime += currentTime - animation->_suspendedAt;
+        }
+    }
+    for (auto timeline : _timelines) {
+        if (timeline && timeline->_owner == scope && timeline->_suspended) {
+            timeline->_suspended = false;
+            timeline->_startTime += currentTime - timeline->_suspendedAt;
+        }
+    }
+}
+
+/*
+@brief Stop every animation of a scope, protected or not, suspended or not.
+
+Values are left where they are. Only the scope's own animations are touched,
+so a view can reset itself without cutting off popups or other views.
+@param scope The scope to cancel.
+*/
+void AnimationManager::cancel(AnimationScope scope) {
+    bool keep[MAX_ANIMATION_COUNT];
+    for (size_t i = 0; i < _groupBegin[EASING_TYPE_COUNT]; ++i) {
+        keep[i] = _owner[i] != scope;
+    }
+    compactTweens(keep);
+    _suspendedTweens.erase(std::remove_if(_suspendedTweens.begin(), _suspendedTweens.end(),
+                                          [scope](const SuspendedTween& tween) { return tween.owner == scope; }),
+                           _suspendedTweens.end());
+
+    for (size_t i = _springCount; i-- > 0;) {
+        if (_springOwner[i] == scope) {
+            removeSpring(i);
+        }
+    }
+
+    auto vecWritePos = _vecAnimations.begin();
+    for (VecAnimationBase* animation : _vecAnimations) {
+        if (animation->_owner != scope) {
+            *vecWritePos++ = animation;
+        } else {
+            animation->_manager = nullptr;
+        }
+    }
+    _vecAnimations.erase(vecWritePos, _vecAnimations.end());
+
+    for (auto& timeline : _timelines) {
+        if (timeline && timeline->_owner == scope) {
+            timeline->_manager = nullptr;
+            timeline = nullptr;
+        }
+    }
+}
+
+/*
+@brief Find a tween parked by a suspended scope.
+@param handle Handle returned by animate().
+@return Index into the parked tweens, or -1 if the tween is not parked.
+*/
+int AnimationManager::findSuspendedTween(AnimationHandle handle) const {
+    if (!handle.isValid()) {
+        return -1;
+    }
+    for (size_t i = 0; i < _suspendedTweens.size(); ++i) {
+        if (_suspendedTweens[i].id == handle.id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/*
+@brief Forget the parked tween of a value, if any, so it is not resumed over a newer animation.
+@param target Address of the animated value.
+*/
+void AnimationManager::dropSuspendedTween(const int32_t* target) {
+    for (auto it = _suspendedTweens.begin(); it != _suspendedTweens.end(); ++it) {
+        if (it->target == target) {
+            _suspendedTweens.erase(it);
+            return;
+        }
+    }
 }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/blit/blitter.h"
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BLIT_HAS_SSE2 1
+#endif
+
+namespace {
+
+// the widest integer the target handles natively
+using BlitWord = std::conditional<sizeof(void*) >= 8, uint64_t, uint32_t>::type;
+
+inline BlitWord loadWord(const uint8_t* p) {
+    BlitWord word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+inline void storeWord(uint8_t* p, BlitWord word) {
+    memcpy(p, &word, sizeof(word));
+}
+
+// evenMask at even byte offsets, independent of endianness
+inline BlitWord patternWord(uint8_t evenMask, uint8_t oddMask) {
+    uint8_t bytes[sizeof(BlitWord)];
+    for (size_t i = 0; i < sizeof(bytes); ++i) bytes[i] = (i % 2) ? oddMask : evenMask;
+    return loadWord(bytes);
+}
+
+/**
+ * @brief Walks [0, len) in vector, word and byte steps.
+ * All steps but the last are even, so byte parity is the same in every kernel.
+ */
+template <typename VectorOp, typename WordOp, typename ByteOp>
+inline void forEachSpan(size_t len, VectorOp vectorOp, WordOp wordOp, ByteOp byteOp) {
+    size_t i = 0;
+#ifdef BLIT_HAS_SSE2
+    for (; i + 16 <= len; i += 16) vectorOp(i);
+#else
+    (void)vectorOp;
+#endif
+    for (; i + sizeof(BlitWord) <= len; i += sizeof(BlitWord)) wordOp(i);
+    for (; i < len; ++i) byteOp(i);
+}
+
+} // namespace
+
+void Blitter::fill(uint8_t* dst, size_t len, uint8_t value) {
+    memset(dst, value, len);
+}
+
+void Blitter::copy(uint8_t* dst, const uint8_t* src, size_t len) {
+    memmove(dst, src, len);
+}
+
+void Blitter::invert(uint8_t* dst, size_t len) {
+    forEachSpan(len,
+        [&](size_t i) {
+#ifdef BLIT_HAS_SSE2
+            __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+            _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), _mm_set1_epi8(-1)));
+#endif
+        },
+        [&](size_t i) { storeWord(dst + i, ~loadWord(dst + i)); },
+        [&](size_t i) { dst[i] = ~dst[i]; });
+}
+
+void Blitter::mask(uint8_t* dst, size_t len, uint8_t evenMask, uint8_t oddMask) {
+#ifdef BLIT_HAS_SSE2
+    const __m128i vectorMask = _mm_set1_epi16((int16_t)(evenMask | (oddMask << 8)));
+#endif
+    const BlitWord wordMask = patternWord(evenMask, oddMask);
+    forEachSpan(len,
+        [&](size_t i) {
+#ifdef BLIT_HAS_SSE2
+            __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+            _mm_storeu_si128(p, _mm_and_si128(_mm_loadu_si128(p), vectorMask));
+#endif
+        },
+        [&](size_t i) { storeWord(dst + i, loadWord(dst + i) & wordMask); },
+        [&](size_t i) { dst[i] &= (i % 2) ? oddMask : evenMask; });
+}
+
+void Blitter::blend(uint8_t* dst, const uint8_t* src, size_t len, uint8_t evenMask, uint8_t oddMask) {
+#ifdef BLIT_HAS_SSE2
+    const __m128i vectorMask = _mm_set1_epi16((int16_t)(evenMask | (oddMask << 8)));
+#endif
+    const BlitWord wordMask = patternWord(evenMask, oddMask);
+    forEachSpan(len,
+        [&](size_t i) {
+#ifdef BLIT_HAS_SSE2
+            __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(p), vectorMask),
+                                             _mm_andnot_si128(vectorMask, s)));
+#endif
+        },
+        [&](size_t i) { storeWord(dst + i, (loadWord(dst + i) & wordMask) | (loadWord(src + i) & ~wordMask)); },
+        [&](size_t i) {
+            uint8_t m = (i % 2) ? oddMask : evenMask;
+            dst[i] = (dst[i] & m) | (src[i] & ~m);
+        });
+}
+
+void Blitter::merge(uint8_t* dst, const uint8_t* src, size_t len, uint8_t rowMask) {
+#ifdef BLIT_HAS_SSE2
+    const __m128i vectorMask = _mm_set1_epi8((char)rowMask);
+#endif
+    const BlitWord wordMask = patternWord(rowMask, rowMask);
+    forEachSpan(len,
+        [&](size_t i) {
+#ifdef BLIT_HAS_SSE2
+            __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(p, _mm_or_si128(_mm_loadu_si128(p), _mm_and_si128(s, vectorMask)));
+#endif
+        },
+        [&](size_t i) { storeWord(dst + i, loadWord(dst + i) | (loadWord(src + i) & wordMask)); },
+        [&](size_t i) { dst[i] |= src[i] & rowMask; });
+}
+
+void Blitter::fillRect(uint8_t* buffer, uint8_t tileWidth, uint16_t x, uint8_t page, uint16_t w, uint8_t pages, uint8_t value) {
+    const size_t stride = (size_t)tileWidth * 8;
+    for (int p = page; p < page + pages; ++p) fill(buffer + p * stride + x, w, value);
+}
+
+void Blitter::invertRect(uint8_t* buffer, uint8_t tileWidth, uint16_t x, uint8_t page, uint16_t w, uint8_t pages) {
+    const size_t stride = (size_t)tileWidth * 8;
+    for (int p = page; p < page + pages; ++p) invert(buffer + p * stride + x, w);
+}
+
+void Blitter::copyRect(uint8_t* dst, const uint8_t* src, uint8_t tileWidth, uint16_t x, uint8_t page, uint16_t w, uint8_t pages) {
+    const size_t stride = (size_t)tileWidth * 8;
+    for (int p = page; p < page + pages; ++p) copy(dst + p * stride + x, src + p * stride + x, w);
+}
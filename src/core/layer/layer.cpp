@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/layer/layer.h"
+#include "core/blit/blitter.h"
+#include "PixelUI.h"
+#include <algorithm>
+#include <assert.h>
+
+Layer::Layer(PixelUI& ui) : m_ui(ui) {}
+
+void Layer::setBounds(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    const uint16_t bufferWidth = m_ui.getU8G2().getBufferTileWidth() * 8;
+    assert(w > 0 && h > 0 && x + w <= bufferWidth);
+    if (w == 0 || h == 0 || x + w > bufferWidth) return;
+
+    uint8_t firstPage = y / 8;
+    uint8_t pages = (y + h + 7) / 8 - firstPage;
+    assert(pages <= 32); // one bit per page in _validPages
+    if (!_cache || (size_t)w * pages > (size_t)_w * _pages) {
+        _cache.reset(new uint8_t[(size_t)w * pages]);
+    }
+    _x = x; _y = y; _w = w; _h = h;
+    _firstPage = firstPage;
+    _pages = pages;
+    invalidate();
+}
+
+void Layer::setPaint(PaintFunction paint) {
+    _paint = std::move(paint);
+    invalidate();
+}
+
+/**
+ * @brief Composites the layer into the frame buffer, painting it first if needed.
+ *
+ * Only the pages present in the buffer are touched, so the same call works for each
+ * page of a paged u8g2 buffer; pages are painted as they first come into view.
+ */
+void Layer::draw() {
+    if (!_cache || !_paint) return;
+
+    U8G2& display = m_ui.getU8G2();
+    const u8g2_t* u8g2 = display.getU8g2();
+    uint8_t* buffer = display.getBufferPtr();
+    const size_t stride = (size_t)display.getBufferTileWidth() * 8;
+    const int bufferFirst = display.getBufferCurrTileRow();
+
+    int first = std::max<int>(_firstPage, bufferFirst);
+    int last = std::min<int>(_firstPage + _pages, bufferFirst + display.getBufferTileHeight());
+    if (first >= last) return;
+
+    uint32_t wanted = (last - first >= 32 ? UINT32_MAX : (1u << (last - first)) - 1) << (first - _firstPage);
+    if ((_validPages & wanted) != wanted) {
+        rasterize(buffer, stride, first, last);
+        _validPages |= wanted;
+    }
+
+    // the visible part: layer bounds within the clip window and the buffer's page window
+    if (!u8g2->is_page_clip_window_intersection) return;
+    int x0 = std::max<int>(_x, u8g2->user_x0);
+    int x1 = std::min<int>(_x + _w, u8g2->user_x1);
+    int y0 = std::max<int>(_y, u8g2->user_y0);
+    int y1 = std::min<int>(_y + _h, u8g2->user_y1);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int page = first; page < last; ++page) {
+        int top = std::max(y0 - page * 8, 0);
+        int bottom = std::min(y1 - page * 8, 8);
+        if (top >= bottom) continue;
+        uint8_t rowMask = (uint8_t)((0xFF << top) & (0xFF >> (8 - bottom)));
+        Blitter::merge(buffer + (page - bufferFirst) * stride + x0,
+                       _cache.get() + (page - _firstPage) * _w + (x0 - _x),
+                       x1 - x0, rowMask);
+    }
+}
+
+/**
+ * @brief Runs the paint function for pages [first, last) and keeps the result.
+ *
+ * The paint goes through the frame buffer itself, so every u8g2 call works unchanged:
+ * the frame's bytes under the layer are parked in the cache, the span is cleared and
+ * painted, and then the two are swapped back.
+ */
+void Layer::rasterize(uint8_t* buffer, size_t stride, int first, int last) {
+    U8G2& display = m_ui.getU8G2();
+    u8g2_t* u8g2 = display.getU8g2();
+    const int bufferFirst = display.getBufferCurrTileRow();
+
+    for (int page = first; page < last; ++page) {
+        uint8_t* row = buffer + (page - bufferFirst) * stride + _x;
+        Blitter::copy(_cache.get() + (page - _firstPage) * _w, row, _w);
+        Blitter::fill(row, _w, 0);
+    }
+
+    // paint state changed inside the paint function must not leak into the frame
+    const u8g2_uint_t clipX0 = u8g2->clip_x0, clipY0 = u8g2->clip_y0;
+    const u8g2_uint_t clipX1 = u8g2->clip_x1, clipY1 = u8g2->clip_y1;
+    const uint8_t* font = u8g2->font;
+    const uint8_t color = display.getDrawColor();
+
+    display.setClipWindow(_x, _y, _x + _w, _y + _h);
+    _paint(display);
+
+    display.setClipWindow(clipX0, clipY0, clipX1, clipY1);
+    display.setDrawColor(color);
+    if (font) display.setFont(font);
+
+    for (int page = first; page < last; ++page) {
+        uint8_t* row = buffer + (page - bufferFirst) * stride + _x;
+        uint8_t* cached = _cache.get() + (page - _firstPage) * _w;
+        std::swap_ranges(row, row + _w, cached);
+    }
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/text/glyph_cache.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <assert.h>
+
+// exported by u8g2_font.c but not declared in u8g2.h
+extern "C" {
+const uint8_t* u8g2_font_get_glyph_data(u8g2_t* u8g2, uint16_t encoding);
+uint8_t u8g2_font_decode_get_unsigned_bits(u8g2_font_decode_t* f, uint8_t cnt);
+int8_t u8g2_font_decode_get_signed_bits(u8g2_font_decode_t* f, uint8_t cnt);
+}
+
+void GlyphCache::setBudget(size_t bytes) {
+    assert(bytes <= UINT16_MAX); // bitmap offsets are 16 bit
+    bytes = std::min<size_t>(bytes, UINT16_MAX);
+    if (bytes != _budget) {
+        _arena.reset(bytes ? new uint8_t[bytes] : nullptr);
+        _budget = bytes;
+    }
+    clear();
+}
+
+void GlyphCache::clear() {
+    _entryCount = 0;
+    _bitmapStart = _budget;
+    std::fill(std::begin(_buckets), std::end(_buckets), -1);
+    _stats.bytesUsed = 0;
+}
+
+/**
+ * @brief The string loop of u8g2_draw_string(), with cached glyphs blitted directly.
+ */
+u8g2_uint_t GlyphCache::draw(u8g2_uint_t x, u8g2_uint_t y, const char* str, size_t length, bool utf8) {
+    if (!str) return 0;
+    u8g2_t* u8g2 = m_u8g2.getU8g2();
+    const bool cached = canBlit();
+    u8x8_t* u8x8 = u8g2_GetU8x8(u8g2);
+    u8x8_utf8_init(u8x8);
+
+    u8g2_uint_t sum = 0;
+    for (const char* end = length == SIZE_MAX ? nullptr : str + length; str != end; ++str) {
+        uint16_t code = utf8 ? u8x8_utf8_next(u8x8, (uint8_t)*str) : u8x8_ascii_next(u8x8, (uint8_t)*str);
+        if (code == 0x0ffff) break;
+        if (code == 0x0fffe) continue;
+
+        const Entry* entry = nullptr;
+        if (cached) {
+            entry = find(code);
+            if (entry) ++_stats.hits;
+            else entry = insert(code);
+        }
+
+        u8g2_uint_t delta;
+        if (entry) {
+            blit(*entry, x, y);
+            delta = entry->glyph.advance;
+        } else {
+            delta = u8g2_DrawGlyph(u8g2, x, y, code);
+        }
+#ifdef U8G2_WITH_FONT_ROTATION
+        switch (u8g2->font_decode.dir) {
+            case 0: x += delta; break;
+            case 1: y += delta; break;
+            case 2: x -= delta; break;
+            case 3: y -= delta; break;
+        }
+#else
+        x += delta;
+#endif
+        sum += delta;
+    }
+    return sum;
+}
+
+bool GlyphCache::canBlit() const {
+    const u8g2_t* u8g2 = m_u8g2.getU8g2();
+    if (!_budget || !u8g2->font) return false;
+#ifdef U8G2_WITH_FONT_ROTATION
+    if (u8g2->font_decode.dir != 0) return false;
+#endif
+    return canDrawBitmap(u8g2);
+}
+
+bool GlyphCache::canDrawBitmap(const u8g2_t* u8g2) {
+    return u8g2->cb->draw_l90 == u8g2_draw_l90_r0 && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb;
+}
+
+uint8_t GlyphCache::bucketOf(const uint8_t* font, uint16_t code) {
+    return (uint8_t)((code ^ ((uintptr_t)font >> 4)) % GLYPH_CACHE_BUCKETS);
+}
+
+const GlyphCache::Entry* GlyphCache::find(uint16_t code) {
+    const uint8_t* font = m_u8g2.getU8g2()->font;
+    for (int16_t i = _buckets[bucketOf(font, code)]; i >= 0; i = entries()[i].next) {
+        const Entry& entry = entries()[i];
+        if (entry.code == code && entry.font == font) return &entry;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Decodes a glyph of the current font into the cache, emptying it first if it is full.
+ *
+ * Glyphs missing from the font are kept too, as empty entries.
+ * @return The entry, nullptr if the glyph cannot be cached and must go through u8g2.
+ */
+const GlyphCache::Entry* GlyphCache::insert(uint16_t code) {
+    u8g2_t* u8g2 = m_u8g2.getU8g2();
+    ++_stats.misses;
+
+    Entry entry = { u8g2->font, code, -1, 0, {} };
+    u8g2_font_decode_t decoder;
+    readGlyph(u8g2, code, entry.glyph, decoder);
+    if (entry.glyph.height > 32) return nullptr; // columns are blitted as 32 bit words
+
+    const size_t bitmapSize = (size_t)(entry.glyph.height + 7) / 8 * entry.glyph.width;
+    if ((size_t)(_entryCount + 1) * sizeof(Entry) + bitmapSize > _bitmapStart) {
+        if (sizeof(Entry) + bitmapSize > _budget) return nullptr;
+        clear();
+        ++_stats.flushes;
+    }
+
+    _bitmapStart -= bitmapSize;
+    entry.bitmap = (uint16_t)_bitmapStart;
+    uint8_t* bitmap = _arena.get() + _bitmapStart;
+    std::memset(bitmap, 0, bitmapSize);
+    if (entry.glyph.width > 0) decodeGlyph(u8g2, decoder, entry.glyph, bitmap, entry.glyph.width);
+
+    const uint8_t bucket = bucketOf(entry.font, code);
+    entry.next = _buckets[bucket];
+    _buckets[bucket] = _entryCount;
+    Entry* slot = new (&entries()[_entryCount]) Entry(entry);
+    ++_entryCount;
+    _stats.bytesUsed = _entryCount * sizeof(Entry) + (_budget - _bitmapStart);
+    return slot;
+}
+
+bool GlyphCache::readGlyph(u8g2_t* u8g2, uint16_t code, Glyph& glyph, u8g2_font_decode_t& decoder) {
+    const u8g2_font_info_t& info = u8g2->font_info;
+    glyph = Glyph();
+    decoder = u8g2_font_decode_t();
+    decoder.decode_ptr = u8g2_font_get_glyph_data(u8g2, code);
+    if (!decoder.decode_ptr) return false;
+
+    glyph.width = u8g2_font_decode_get_unsigned_bits(&decoder, info.bits_per_char_width);
+    glyph.height = u8g2_font_decode_get_unsigned_bits(&decoder, info.bits_per_char_height);
+    glyph.xOffset = u8g2_font_decode_get_signed_bits(&decoder, info.bits_per_char_x);
+    glyph.yOffset = u8g2_font_decode_get_signed_bits(&decoder, info.bits_per_char_y);
+    glyph.advance = u8g2_font_decode_get_signed_bits(&decoder, info.bits_per_delta_x);
+    return true;
+}
+
+/**
+ * @brief Mirrors u8g2_font_decode_glyph(): runs of background and foreground pixels fill
+ * the glyph box row by row.
+ */
+void GlyphCache::decodeGlyph(u8g2_t* u8g2, u8g2_font_decode_t& decoder, const Glyph& glyph,
+                             uint8_t* bitmap, size_t stride, uint8_t rowOffset) {
+    if (glyph.width == 0) return;
+    const u8g2_font_info_t& info = u8g2->font_info;
+    uint8_t lx = 0, ly = 0;
+    auto run = [&](uint8_t count, bool foreground) {
+        for (;;) {
+            uint8_t remaining = glyph.width - lx;
+            uint8_t current = std::min(count, remaining);
+            if (foreground && ly < glyph.height) {
+                const unsigned row = ly + rowOffset;
+                uint8_t* column = bitmap + (row / 8) * stride + lx;
+                for (uint8_t i = 0; i < current; ++i) column[i] |= 1 << (row % 8);
+            }
+            if (count < remaining) break;
+            count -= remaining;
+            lx = 0;
+            ly++;
+        }
+        lx += count;
+    };
+    for (;;) {
+        uint8_t background = u8g2_font_decode_get_unsigned_bits(&decoder, info.bits_per_0);
+        uint8_t foreground = u8g2_font_decode_get_unsigned_bits(&decoder, info.bits_per_1);
+        do {
+            run(background, false);
+            run(foreground, true);
+        } while (u8g2_font_decode_get_unsigned_bits(&decoder, 1) != 0);
+        if (ly >= glyph.height) break;
+    }
+}
+
+/**
+ * @brief Writes a cached glyph into the buffer like u8g2_DrawGlyph() would.
+ */
+void GlyphCache::blit(const Entry& entry, u8g2_uint_t x, u8g2_uint_t y) {
+    u8g2_t* u8g2 = m_u8g2.getU8g2();
+    // u8g2 draws nothing for an empty glyph, not even the background
+    if (entry.glyph.width == 0) return;
+
+    y += u8g2->font_calc_vref(u8g2);
+    drawBitmap(u8g2, _arena.get() + entry.bitmap, entry.glyph.width, entry.glyph.height,
+               x + entry.glyph.xOffset, y - (entry.glyph.height + entry.glyph.yOffset),
+               !u8g2->font_decode.is_transparent);
+}
+
+/**
+ * @brief In solid mode the background color is set for draw color 0 and cleared otherwise.
+ */
+void GlyphCache::drawBitmap(u8g2_t* u8g2, const uint8_t* bitmap, uint16_t width, uint8_t height,
+                            u8g2_uint_t left, u8g2_uint_t top, bool solid) {
+    assert(height <= 32);
+    // u8g2 draws nothing while the clip window misses the current page (user_* are stale then)
+    if (width == 0 || height == 0 || height > 32 || !u8g2->is_page_clip_window_intersection) return;
+
+    // columns: the clip window applied like u8g2_clip_intersection2(), which also
+    // keeps the visible part of a bitmap starting left of 0
+    u8g2_uint_t x0 = left;
+    u8g2_uint_t x1 = left + width;
+    if (x0 > x1) {
+        if (x0 < u8g2->user_x1) x1 = u8g2->user_x1 - 1;
+        else x0 = u8g2->user_x0;
+    }
+    if (x0 >= u8g2->user_x1 || x1 <= u8g2->user_x0) return;
+    x0 = std::max(x0, u8g2->user_x0);
+    x1 = std::min(x1, u8g2->user_x1);
+
+    // rows inside the clip window and the current page window
+    uint32_t rows = 0;
+    for (uint8_t r = 0; r < height; ++r) {
+        u8g2_uint_t row = top + r;
+        if (row >= u8g2->user_y0 && row < u8g2->user_y1) rows |= 1u << r;
+    }
+    if (!rows) return;
+    int firstRow = 0, lastRow = 31;
+    while (!(rows & (1u << firstRow))) ++firstRow;
+    while (!(rows & (1u << lastRow))) --lastRow;
+    const int32_t bitmapTop = (int32_t)(u8g2_uint_t)(top + firstRow) - firstRow; // screen row of bitmap row 0
+
+    const uint8_t color = u8g2->draw_color;
+    const uint8_t backgroundColor = color == 0 ? 1 : 0;
+    const size_t stride = (size_t)u8g2_GetU8x8(u8g2)->display_info->tile_width * 8;
+    const int firstPage = (bitmapTop + firstRow) / 8;
+    const int lastPage = (bitmapTop + lastRow) / 8;
+    const uint8_t pages = (height + 7) / 8;
+
+    for (u8g2_uint_t screenX = x0; screenX < x1; ++screenX) {
+        const uint16_t column = (u8g2_uint_t)(screenX - left);
+        uint32_t bits = 0;
+        for (uint8_t p = 0; p < pages; ++p) bits |= (uint32_t)bitmap[p * width + column] << (p * 8);
+        const uint32_t foreground = bits & rows;
+        const uint32_t background = solid ? ~bits & rows : 0;
+
+        for (int page = firstPage; page <= lastPage; ++page) {
+            const int shift = page * 8 - bitmapTop; // bitmap row at the top of this page
+            const uint8_t fg = shift >= 0 ? foreground >> shift : foreground << -shift;
+            const uint8_t bg = shift >= 0 ? background >> shift : background << -shift;
+            uint8_t* dst = u8g2->tile_buf_ptr + (page * 8 - u8g2->pixel_curr_row) / 8 * stride + screenX;
+            if (color == 1) *dst |= fg;
+            else if (color == 0) *dst &= ~fg;
+            else *dst ^= fg;
+            if (backgroundColor) *dst |= bg;
+            else *dst &= ~bg;
+        }
+    }
+}
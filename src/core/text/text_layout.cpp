@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/text/text_layout.h"
+#include "core/text/text_metrics.h"
+#include "PixelUI.h"
+#include <algorithm>
+
+uint16_t TextLayout::layout(const char* text, uint16_t maxWidth, uint16_t maxLines) {
+    U8G2& display = m_ui.getU8G2();
+    const uint8_t* font = display.getU8g2()->font;
+    maxLines = std::min<uint16_t>(maxLines, _lines.capacity());
+    if (text == _text && font == _font && maxWidth == _maxWidth && maxLines == _maxLines) {
+        return _lines.size();
+    }
+
+    _lines.clear();
+    _text = text;
+    _font = font;
+    _maxWidth = maxWidth;
+    _maxLines = maxLines;
+    if (!text || !font) return 0;
+
+    TextMetrics& metrics = m_ui.getTextMetrics();
+    u8x8_t* u8x8 = u8g2_GetU8x8(display.getU8g2());
+    const char* p = text;
+    while (*p && _lines.size() < maxLines) {
+        const char* lineStart = p;
+        const char* glyphStart = p;
+        const char* breakAt = nullptr; // the last space the line may end at
+        int32_t pen = 0;
+
+        u8x8_utf8_init(u8x8);
+        while (*p && *p != '\n') {
+            uint16_t code = u8x8_utf8_next(u8x8, (uint8_t)*p++);
+            if (code == 0x0fffe) continue; // inside a multi byte sequence
+
+            TextMetrics::Glyph glyph = metrics.getGlyph(code);
+            if (code == ' ') {
+                breakAt = glyphStart;
+            } else if (glyphStart > lineStart
+                       && pen + (glyph.width ? glyph.xOffset + glyph.width : glyph.advance) > maxWidth) {
+                // keep at least one glyph per line, so a narrow width cannot stall
+                p = breakAt && breakAt > lineStart ? breakAt : glyphStart;
+                break;
+            }
+            pen += glyph.advance;
+            glyphStart = p;
+        }
+
+        const char* lineEnd = p;
+        while (lineEnd > lineStart && lineEnd[-1] == ' ') --lineEnd;
+        uint16_t length = lineEnd - lineStart;
+        _lines.push_back({ lineStart, length, (uint16_t)metrics.getUTF8Width(lineStart, length) });
+
+        // the next line starts after the spaces at the break, or after an explicit newline
+        while (*p == ' ') ++p;
+        if (*p == '\n') ++p;
+    }
+    return _lines.size();
+}
+
+u8g2_uint_t TextLayout::drawSpan(u8g2_uint_t x, u8g2_uint_t y, const TextSpan& span) {
+    return m_ui.getGlyphCache().drawUTF8(x, y, span.start, span.length);
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/text/text_metrics.h"
+#include <algorithm>
+#include <assert.h>
+
+void TextMetrics::clear() {
+    for (std::unique_ptr<FontCache>& cache : m_fonts) {
+        cache.reset();
+    }
+    for (StaticWidth& entry : m_static) {
+        entry = StaticWidth();
+    }
+    m_current = nullptr;
+}
+
+/**
+ * @brief Sums the glyphs like u8g2_string_width(): advances for all glyphs but the last
+ * one found, which counts with its pixel width and x offset instead.
+ */
+u8g2_uint_t TextMetrics::measure(const char* str, size_t length, bool utf8) {
+    if (!str) return 0;
+    u8g2_t* u8g2 = m_u8g2.getU8g2();
+    assert(u8g2->font);
+    if (!u8g2->font) return 0;
+
+    FontCache& cache = fontCache();
+    u8x8_t* u8x8 = u8g2_GetU8x8(u8g2);
+    u8x8_utf8_init(u8x8);
+
+    u8g2_uint_t w = 0;
+    u8g2_uint_t dx = 0;
+    Glyph last;
+#ifdef U8G2_BALANCED_STR_WIDTH_CALCULATION
+    int8_t initialXOffset = -64;
+#endif
+    for (const char* end = length == SIZE_MAX ? nullptr : str + length; str != end; ++str) {
+        uint8_t byte = (uint8_t)*str;
+        uint16_t code = utf8 ? u8x8_utf8_next(u8x8, byte) : u8x8_ascii_next(u8x8, byte);
+        if (code == 0x0ffff) break;
+        if (code == 0x0fffe) continue;
+
+        Glyph g = glyph(cache, code);
+        dx = g.advance;
+        if (g.flags & PRESENT) {
+#ifdef U8G2_BALANCED_STR_WIDTH_CALCULATION
+            if (initialXOffset == -64) initialXOffset = g.xOffset;
+#endif
+            last = g;
+        }
+        w += dx;
+    }
+
+    if (last.width != 0) {
+        w -= dx;
+        w += last.width;
+        w += last.xOffset;
+#ifdef U8G2_BALANCED_STR_WIDTH_CALCULATION
+        if (initialXOffset > 0) w += initialXOffset;
+#endif
+    }
+    return w;
+}
+
+size_t TextMetrics::fitUTF8(const char* str, u8g2_uint_t maxWidth) {
+    if (!str || !m_u8g2.getU8g2()->font) return 0;
+    FontCache& cache = fontCache();
+    u8x8_t* u8x8 = u8g2_GetU8x8(m_u8g2.getU8g2());
+    u8x8_utf8_init(u8x8);
+
+    int32_t pen = 0;
+    const char* fits = str; // end of the prefix known to fit
+    for (const char* p = str; *p;) {
+        uint16_t code = u8x8_utf8_next(u8x8, (uint8_t)*p++);
+        if (code == 0x0ffff) break;
+        if (code == 0x0fffe) continue;
+        Glyph g = glyph(cache, code);
+        if (pen + (g.width ? g.xOffset + g.width : g.advance) > maxWidth) break;
+        pen += g.advance;
+        fits = p;
+    }
+    return fits - str;
+}
+
+u8g2_uint_t TextMetrics::measureStatic(const char* str, bool utf8) {
+    const uint8_t* font = m_u8g2.getU8g2()->font;
+    for (const StaticWidth& entry : m_static) {
+        if (entry.str == str && entry.font == font && entry.utf8 == utf8) return entry.width;
+    }
+    u8g2_uint_t width = measure(str, SIZE_MAX, utf8);
+    if (str && font) {
+        m_static[m_nextStatic] = { str, font, utf8, width };
+        m_nextStatic = (m_nextStatic + 1) % TEXT_METRICS_STATIC_NUM;
+    }
+    return width;
+}
+
+/**
+ * @brief The cache of the current font, allocating a free slot or taking over the least
+ * recently used one if needed.
+ */
+TextMetrics::FontCache& TextMetrics::fontCache() {
+    const uint8_t* font = m_u8g2.getU8g2()->font;
+    ++m_useCount;
+    if (m_current && m_current->font == font) {
+        m_current->lastUse = m_useCount;
+        return *m_current;
+    }
+
+    std::unique_ptr<FontCache>* victim = nullptr;
+    for (std::unique_ptr<FontCache>& cache : m_fonts) {
+        if (!cache) {
+            if (!victim || *victim) victim = &cache; // a free slot beats evicting a font
+            continue;
+        }
+        if (cache->font == font) {
+            victim = &cache;
+            break;
+        }
+        if (!victim || (*victim && cache->lastUse < (*victim)->lastUse)) victim = &cache;
+    }
+    if (!*victim) {
+        victim->reset(new FontCache());
+        (*victim)->font = font;
+    } else if ((*victim)->font != font) {
+        (*victim)->reuse(font);
+    }
+    (*victim)->lastUse = m_useCount;
+    m_current = victim->get();
+    return **victim;
+}
+
+TextMetrics::Glyph TextMetrics::glyph(FontCache& cache, uint16_t code) {
+    if (code >= FIRST_ASCII && code < FIRST_ASCII + ASCII_COUNT) {
+        Glyph& g = cache.ascii[code - FIRST_ASCII];
+        if (!(g.flags & KNOWN)) g = decode(code);
+        return g;
+    }
+
+    // other glyphs: move to front on a hit, drop the least recently used on a miss
+    uint8_t i = 0;
+    while (i < cache.otherCount && cache.otherCode[i] != code) ++i;
+    Glyph g;
+    if (i < cache.otherCount) {
+        g = cache.other[i];
+    } else {
+        g = decode(code);
+        if (cache.otherCount < TEXT_METRICS_OTHER_GLYPHS) ++cache.otherCount;
+        i = cache.otherCount - 1;
+    }
+    std::copy_backward(cache.otherCode, cache.otherCode + i, cache.otherCode + i + 1);
+    std::copy_backward(cache.other, cache.other + i, cache.other + i + 1);
+    cache.otherCode[0] = code;
+    cache.other[0] = g;
+    return g;
+}
+
+TextMetrics::Glyph TextMetrics::decode(uint16_t code) {
+    u8g2_t* u8g2 = m_u8g2.getU8g2();
+    Glyph g;
+    g.flags = KNOWN;
+    if (!u8g2_IsGlyph(u8g2, code)) return g;
+
+    // the pixel width and x offset are side effects of u8g2_GetGlyphWidth()
+    g.advance = u8g2_GetGlyphWidth(u8g2, code);
+    g.xOffset = u8g2->glyph_x_offset;
+    g.width = u8g2->font_decode.glyph_width;
+    g.flags |= PRESENT;
+    return g;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/text/text_strip.h"
+#include "core/text/glyph_cache.h"
+#include "core/text/text_metrics.h"
+#include "PixelUI.h"
+#include <algorithm>
+#include <cstring>
+
+uint16_t TextStrip::setText(const char* text) {
+    const uint8_t* font = m_ui.getU8G2().getU8g2()->font;
+    const uint32_t textHash = hash(text);
+    if (text == _text && font == _font && textHash == _hash) return _textWidth;
+
+    _text = text;
+    _font = font;
+    _hash = textHash;
+    _textWidth = text && font ? m_ui.getTextMetrics().getUTF8Width(text) : 0;
+    render();
+    return _textWidth;
+}
+
+void TextStrip::draw(u8g2_uint_t x, u8g2_uint_t y) {
+    if (!_text) return;
+    U8G2& display = m_ui.getU8G2();
+    u8g2_t* u8g2 = display.getU8g2();
+    if (!_rasterized || u8g2->font != _font || !GlyphCache::canDrawBitmap(u8g2)) {
+        display.drawUTF8(x, y, _text);
+        return;
+    }
+    y += u8g2->font_calc_vref(u8g2);
+    GlyphCache::drawBitmap(u8g2, _bitmap.get(), _width, _height, x + _left, y + _top, false);
+}
+
+uint32_t TextStrip::hash(const char* text) {
+    uint32_t h = 2166136261u;
+    for (const char* c = text; c && *c; ++c) h = (h ^ (uint8_t)*c) * 16777619u;
+    return h;
+}
+
+/**
+ * @brief Decodes the glyphs side by side into the strip: one pass finds the columns they
+ * cover, a second decodes each at its pen position, placed in the font bounding box.
+ */
+void TextStrip::render() {
+    _rasterized = false;
+    u8g2_t* u8g2 = m_ui.getU8G2().getU8g2();
+    if (!_text || !_font) return;
+#ifdef U8G2_WITH_FONT_ROTATION
+    if (u8g2->font_decode.dir != 0) return;
+#endif
+    const u8g2_font_info_t& info = u8g2->font_info;
+    if (info.max_char_height == 0 || info.max_char_height > 32) return; // drawn as 32 bit columns
+
+    TextMetrics& metrics = m_ui.getTextMetrics();
+    u8x8_t* u8x8 = u8g2_GetU8x8(u8g2);
+    int32_t pen = 0, left = 0, right = 0;
+    u8x8_utf8_init(u8x8);
+    for (const char* p = _text; *p; ++p) {
+        uint16_t code = u8x8_utf8_next(u8x8, (uint8_t)*p);
+        if (code == 0x0ffff) break;
+        if (code == 0x0fffe) continue;
+        TextMetrics::Glyph glyph = metrics.getGlyph(code);
+        if (glyph.width) {
+            left = std::min<int32_t>(left, pen + glyph.xOffset);
+            right = std::max<int32_t>(right, pen + glyph.xOffset + glyph.width);
+        }
+        pen += glyph.advance;
+    }
+    if (right <= left || right - left > UINT16_MAX) return;
+
+    _width = right - left;
+    _height = info.max_char_height;
+    _left = left;
+    _top = -(info.max_char_height + info.y_offset);
+    const size_t size = (size_t)(_height + 7) / 8 * _width;
+    if (size > _capacity) {
+        _bitmap.reset(new uint8_t[size]);
+        _capacity = size;
+    }
+    std::memset(_bitmap.get(), 0, size);
+
+    pen = 0;
+    u8x8_utf8_init(u8x8);
+    for (const char* p = _text; *p; ++p) {
+        uint16_t code = u8x8_utf8_next(u8x8, (uint8_t)*p);
+        if (code == 0x0ffff) break;
+        if (code == 0x0fffe) continue;
+        GlyphCache::Glyph glyph;
+        u8g2_font_decode_t decoder;
+        if (GlyphCache::readGlyph(u8g2, code, glyph, decoder) && glyph.width) {
+            const int row = (info.max_char_height + info.y_offset) - (glyph.height + glyph.yOffset);
+            if (row >= 0 && row + glyph.height <= _height) {
+                GlyphCache::decodeGlyph(u8g2, decoder, glyph, _bitmap.get() + (pen + glyph.xOffset - left), _width, row);
+            }
+        }
+        pen += glyph.advance;
+    }
+    _rasterized = true;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2025 Lawrence Link
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/transition/transition.h"
+#include "core/animation/animation.h"
+#include "core/blit/blitter.h"
+#include <algorithm>
+
+/**
+ * @brief Starts a transition away from the given frame.
+ */
+void Transition::start(TransitionType type, uint32_t duration, uint32_t currentTime,
+                       const uint8_t* frame, uint8_t tileWidth, uint8_t tileHeight) {
+    _hasFrom = frame != nullptr;
+    if (_hasFrom) {
+        size_t size = (size_t)tileWidth * tileHeight * 8;
+        if (size > _capacity) {
+            _from.reset(new uint8_t[size]);
+            _capacity = size;
+        }
+        Blitter::copy(_from.get(), frame, size);
+    }
+
+    if (!duration) {
+        switch (type) {
+            case TransitionType::DITHER_FADE: duration = TRANSITION_FADE_MS; break;
+            case TransitionType::WIPE:        duration = TRANSITION_WIPE_MS; break;
+            default:                          duration = TRANSITION_SLIDE_MS; break;
+        }
+    }
+    _type = type;
+    _startTime = currentTime;
+    _duration = duration;
+    _tileWidth = tileWidth;
+    _tileHeight = tileHeight;
+    _active = true;
+}
+
+/**
+ * @brief Blends the old frame into a freshly rendered buffer.
+ *
+ * The buffer is a row of columns per 8 pixel page, one byte per column, so moving
+ * content sideways is a byte copy per page.
+ * - DITHER_FADE dissolves in three steps of a checkerboard pattern, like the old fade.
+ * - SLIDE_LEFT / SLIDE_RIGHT push the old frame out while the new one follows it in.
+ * - WIPE reveals the new frame from the left edge.
+ * Without an old frame, blank pixels take its place.
+ */
+void Transition::apply(uint8_t* buffer, uint32_t currentTime, uint8_t firstPage, uint8_t pages) {
+    if (!_active) return;
+    uint32_t elapsed = currentTime - _startTime;
+    if (elapsed >= _duration) {
+        _active = false; // the new content is shown untouched from here on
+        return;
+    }
+
+    const size_t width = (size_t)_tileWidth * 8;
+    if (!pages) pages = _tileHeight - firstPage;
+    const uint8_t* from = _hasFrom ? _from.get() + firstPage * width : nullptr;
+
+    if (_type == TransitionType::DITHER_FADE) {
+        // bits of the new frame kept in even and odd columns, the rest comes from the old one
+        static const uint8_t KEEP[3][2] = { {0x00, 0x55}, {0x00, 0xFF}, {0xAA, 0xFF} };
+        uint32_t step = elapsed * 3 / _duration;
+        if (from) {
+            Blitter::blend(buffer, from, width * pages, KEEP[step][0], KEEP[step][1]);
+        } else {
+            Blitter::mask(buffer, width * pages, KEEP[step][0], KEEP[step][1]);
+        }
+        return;
+    }
+
+    int32_t progress = EasingCalculator::calculate(EasingType::EASE_IN_OUT_CUBIC,
+                                                   (int32_t)(((int64_t)elapsed << SHIFT_BITS) / _duration));
+    size_t offset = std::min(width, (size_t)(((int64_t)progress * width) >> SHIFT_BITS));
+
+    for (uint8_t page = 0; page < pages; ++page) {
+        uint8_t* row = buffer + page * width;
+        const uint8_t* old = from ? from + page * width : nullptr;
+        switch (_type) {
+            case TransitionType::SLIDE_LEFT:  // new content enters from the right
+                Blitter::copy(row + width - offset, row, offset);
+                if (old) Blitter::copy(row, old + offset, width - offset);
+                else Blitter::fill(row, width - offset, 0);
+                break;
+            case TransitionType::SLIDE_RIGHT: // new content enters from the left
+                Blitter::copy(row, row + width - offset, offset);
+                if (old) Blitter::copy(row + offset, old, width - offset);
+                else Blitter::fill(row + offset, width - offset, 0);
+                break;
+            default:                          // WIPE
+                if (old) Blitter::copy(row + offset, old + offset, width - offset);
+                else Blitter::fill(row + offset, width - offset, 0);
+                break;
+        }
+    }
+}
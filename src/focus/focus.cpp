@@ -38,10 +38,11 @@ void FocusManager::moveNext() {
         // Start the animation. The starting values for m_current_focus_box
         // will be automatically inherited from the last drawn state.
         FocusBox target = m_Widgets[index]->getFocusBox();
-        m_ui.animate(m_current_focus_box.x, target.x, 200, EasingType::EASE_OUT_QUAD);
-        m_ui.animate(m_current_focus_box.y, target.y, 200, EasingType::EASE_OUT_QUAD);
-        m_ui.animate(m_current_focus_box.w, target.w, 200, EasingType::EASE_OUT_QUAD);
-        m_ui.animate(m_current_focus_box.h, target.h, 200, EasingType::EASE_OUT_QUAD);
+        m_ui.stopAnimation(m_shrinkAnimation);
+        m_ui.spring(m_current_focus_box.x, target.x, 200);
+        m_ui.spring(m_current_focus_box.y, target.y, 200);
+        m_ui.spring(m_current_focus_box.w, target.w, 200);
+        m_ui.spring(m_current_focus_box.h, target.h, 200);
     }
 }
 
@@ -73,10 +74,11 @@ void FocusManager::movePrev() {
         // Start the animation. The starting values for m_current_focus_box
         // will be automatically inherited from the last drawn state.
         FocusBox target = m_Widgets[index]->getFocusBox();
-        m_ui.animate(m_current_focus_box.x, target.x, 200, EasingType::EASE_OUT_QUAD);
-        m_ui.animate(m_current_focus_box.y, target.y, 200, EasingType::EASE_OUT_QUAD);
-        m_ui.animate(m_current_focus_box.w, target.w, 200, EasingType::EASE_OUT_QUAD);
-        m_ui.animate(m_current_focus_box.h, target.h, 200, EasingType::EASE_OUT_QUAD);
+        m_ui.stopAnimation(m_shrinkAnimation);
+        m_ui.spring(m_current_focus_box.x, target.x, 200);
+        m_ui.spring(m_current_focus_box.y, target.y, 200);
+        m_ui.spring(m_current_focus_box.w, target.w, 200);
+        m_ui.spring(m_current_focus_box.h, target.h, 200);
     }
 }
 
@@ -99,15 +101,14 @@ void FocusManager::selectCurrent() {
 
 
 /**
- * @brief Draws the focus box and handles all animation logic.
+ * @brief Advances the focus state, once per tick.
  *
  * This function is responsible for:
  * - Checking for a focus timeout (e.g., after 2.5 seconds of inactivity).
  * - Initiating the shrink animation when a timeout occurs.
  * - Checking for animation completion.
- * - Drawing the focus box based on the current animation state.
  */
-void FocusManager::draw() {
+void FocusManager::update() {
     // Check if the focus has been on the same widget for more than 2.5 seconds.
     if (m_state != State::IDLE && m_ui.getCurrentTime() - last_focus_change_time > 2500) {
         // If not already shrinking, initiate the shrink animation.
@@ -118,12 +119,8 @@ void FocusManager::draw() {
             int32_t center_x = m_current_focus_box.x + m_current_focus_box.w / 2;
             int32_t center_y = m_current_focus_box.y + m_current_focus_box.h / 2;
 
-            // Start the shrink animation for width and height,
-            // while animating x,y to keep the center stable.
-            m_ui.animate(m_current_focus_box.w, 0, 200, EasingType::EASE_IN_QUAD);
-            m_ui.animate(m_current_focus_box.h, 0, 200, EasingType::EASE_IN_QUAD);
-            m_ui.animate(m_current_focus_box.x, center_x, 200, EasingType::EASE_IN_QUAD);
-            m_ui.animate(m_current_focus_box.y, center_y, 200, EasingType::EASE_IN_QUAD);
+            // Shrink width and height to 0 while moving x,y to keep the center stable.
+            m_ui.animate(m_shrinkAnimation, {center_x, center_y, 0, 0}, 200, EasingType::EASE_IN_QUAD);
         }
     }
 
@@ -134,12 +131,9 @@ void FocusManager::draw() {
             if (m_current_focus_box.w <= 1 && m_current_focus_box.h <= 1) {
                 m_state = State::IDLE;
                 index = -1;
-                return; // Animation finished, return immediately without drawing.
+                return;
             }
         }
-        
-        U8G2& u8g2 = m_ui.getU8G2();
-        u8g2.setDrawColor(2);
 
         // Get the target focus box for the animation endpoint.
         if (index >= 0 && index < (int)m_Widgets.size()) {
@@ -150,6 +144,18 @@ void FocusManager::draw() {
         if (m_state == State::ANIMATING && m_current_focus_box == m_target_focus_box) {
             m_state = State::FOCUSED;
         }
+    }
+}
+
+/**
+ * @brief Draws the focus box based on the current animation state.
+ *
+ * Draws only, as it may run once per page; update() changes the state.
+ */
+void FocusManager::draw() {
+    if (m_state != State::IDLE) {
+        U8G2& u8g2 = m_ui.getU8G2();
+        u8g2.setDrawColor(2);
 
         // Draw the focus box based on the current state.
         switch (m_state) {
@@ -19,8 +19,26 @@
 #include <algorithm>
 #include <cstring>
 
-AppView::AppView(PixelUI& ui, ViewManager& viewManager) : ui_(ui), appManager_(AppManager::getInstance()), m_viewManager(viewManager) {
-    iconSpacing_ = (ui.getU8G2().getWidth() - 3 * iconWidth_ )* 0.25;
+AppView::AppView(PixelUI& ui, ViewManager& viewManager) : ui_(ui), appManager_(AppManager::getInstance()), m_viewManager(viewManager),
+    titleLayer_(ui), trackLayer_(ui) {
+    U8G2& display = ui.getU8G2();
+    iconSpacing_ = (display.getWidth() - 3 * iconWidth_ )* 0.25;
+
+    // static parts are rasterized once and composited every frame
+    display.setFont(u8g2_font_tom_thumb_4x6_mf);
+    uint16_t titleWidth = display.getStrWidth("< Apps >");
+    uint16_t titleX = (display.getWidth() - titleWidth) / 2;
+    titleLayer_.setBounds(titleX, 0, titleWidth, 12);
+    titleLayer_.setPaint([titleX](U8G2& u8g2) {
+        u8g2.setFont(u8g2_font_tom_thumb_4x6_mf);
+        u8g2.drawStr(titleX, 10, "< Apps >");
+    });
+    trackLayer_.setBounds(0, 50, display.getWidth(), 1);
+    trackLayer_.setPaint([](U8G2& u8g2) {
+        for (int x = 0; x < u8g2.getWidth(); x += 2) {
+            u8g2.drawPixel(x, 50);
+        }
+    });
 
     float totalListWidth = 3 * iconWidth_ + 2 * iconSpacing_;
     float firstSlotX = centerX_ - 1.5f * iconWidth_ - iconSpacing_;
@@ -96,15 +114,17 @@ void AppView::draw() {
     
     // Set font and draw title
     display.setFont(u8g2_font_tom_thumb_4x6_mf);
-    display.drawStr((display.getWidth() - display.getStrWidth("< Apps >")) / 2, 10, "< Apps >");
+    titleLayer_.draw();
     
     // Draw selector and app list
     drawSelector(animation_selector_coord_x, 30, animation_selector_length);
     drawHorizontalAppList();
     
-    // Draw progress bar
-    for (int i = 0; i <= static_cast<int>(animation_pixel_dots); i++) {
-        display.drawPixel(i * 2, 50);
+    // Draw progress bar, the dots up to animation_pixel_dots
+    if (animation_pixel_dots >= 0) {
+        display.setClipWindow(0, 0, animation_pixel_dots * 2 + 1, display.getHeight());
+        trackLayer_.draw();
+        display.setMaxClipWindow();
     }
     display.drawHLine(0, 50, animation_scroll_bar);
 
@@ -113,7 +133,7 @@ void AppView::draw() {
     if (!apps.empty()) {
         char statusText[16];
         snprintf(statusText, sizeof(statusText), "%d/%d", currentIndex_ + 1, (int)apps.size());
-        display.drawStr(2, 60, statusText);
+        ui_.getGlyphCache().drawStr(2, 60, statusText);
     }
 }
 
@@ -181,11 +201,13 @@ void AppView::drawHorizontalAppList() {
 void AppView::drawAppIcon(const AppItem& app, int x, int y, bool inCenter) {
     U8G2& display = ui_.getU8G2();
     
-    // Draw the app icon
+    // Draw the app icon, unless it is off the current page or under a popup
     if (app.bitmap) {
         int iconX = x + (iconWidth_ - 24) / 2;
         int iconY = y + (iconHeight_ - 24) / 2;
-        display.drawXBM(iconX, iconY, 24, 24, app.bitmap);
+        if (ui_.isAreaVisible(iconX, iconY, 24, 24)) {
+            display.drawXBM(iconX, iconY, 24, 24, app.bitmap);
+        }
     } else {
         // Draw a placeholder rectangle if no icon is provided
         display.drawRBox(x + 4, y + 4, iconWidth_ - 8, iconHeight_ - 8, 2);
@@ -195,7 +217,7 @@ void AppView::drawAppIcon(const AppItem& app, int x, int y, bool inCenter) {
     display.setFont(u8g2_font_tom_thumb_4x6_mf);
     
     if (inCenter) {
-        display.drawStr((display.getWidth() - display.getStrWidth(app.title)) / 2, appTitle_Y, app.title);
+        ui_.getGlyphCache().drawStr((display.getWidth() - ui_.getTextMetrics().getStaticStrWidth(app.title)) / 2, appTitle_Y, app.title);
     }
 }
 
@@ -226,8 +248,6 @@ void AppView::scrollToIndex(int newIndex) {
     int totalApps = apps.size();
     if (totalApps == 0) return;
 
-    ui_.getAnimationManPtr()->clearUnprotected();
-
     int targetSlot;
     if (newIndex == 0) {
         targetSlot = 0;
@@ -245,8 +265,8 @@ void AppView::scrollToIndex(int newIndex) {
     float iconOriginalCenterX = newIndex * (iconWidth_ + iconSpacing_) + iconWidth_ / 2.0f;
     float targetScrollOffset = iconTargetCenterX - iconOriginalCenterX;
 
-    ui_.animate(animation_selector_coord_x, targetSelectorX, 550, EasingType::EASE_OUT_CUBIC);
-    ui_.animate(scrollOffset_, targetScrollOffset, 350, EasingType::EASE_OUT_CUBIC);
+    ui_.spring(animation_selector_coord_x, targetSelectorX, 550);
+    ui_.spring(scrollOffset_, targetScrollOffset, 350);
     
     updateProgressBar();
     
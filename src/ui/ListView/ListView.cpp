@@ -20,7 +20,6 @@
 
 void ListView::onEnter(ExitCallback exitCallback){
     IApplication::onEnter(exitCallback);
-    m_ui.setContinousDraw(true);
     U8G2& u8g2 = m_ui.getU8G2();
 
     u8g2.setFont(u8g2_font_squeezed_b6_tr);
@@ -30,6 +29,7 @@ void ListView::onEnter(ExitCallback exitCallback){
     scrollOffset_ = 0;
     currentCursor = 0;
     isInitialLoad_ = true;
+    hasDrawn_ = false;
     
     for (int i = 0; i < visibleItemCount_; i++) {
         itemLoadAnimations_[i] = 0;
@@ -42,36 +42,23 @@ void ListView::onEnter(ExitCallback exitCallback){
     scrollToTarget(0);
 }
 /*
-@brief Called when the ListView is resumed from a paused state.
+@brief Slide the visible items in one after another.
 */
 void ListView::startLoadAnimation() {
     isInitialLoad_ = true;
     
     int maxVisible = std::min(visibleItemCount_ + 1, (int)(m_itemLength + 1));
     
+    loadTimeline_.clear();
     for (int i = 0; i < maxVisible; i++) {
-        int duration = 250 + i * 60;
-        
-        bool isLastAnimation = (i == maxVisible - 1);
-        
-        auto callback = [this, i, isLastAnimation](int32_t value) {
-            this->itemLoadAnimations_[i] = value;
-            
-            if (isLastAnimation && value >= FIXED_POINT_ONE) { 
-                this->isInitialLoad_ = false;
-                this->m_ui.getAnimationManPtr()->clearAllProtectionMarks();
-            }
-        };
-
-        auto animation = std::make_shared<CallbackAnimation>(0, FIXED_POINT_ONE, duration, EasingType::EASE_IN_OUT_CUBIC, callback);
-        
-        m_ui.getAnimationManPtr()->markProtected(animation);
-        m_ui.addAnimation(animation);
+        itemLoadAnimations_[i] = 0;
+        loadTimeline_.add(itemLoadAnimations_[i], FIXED_POINT_ONE, 250, EasingType::EASE_IN_OUT_CUBIC, i * 60);
     }
-}
-
-void ListView::clearNonInitialAnimations() {
-    m_ui.getAnimationManPtr()->clearUnprotected();
+    loadTimeline_.onComplete([this]() {
+        isInitialLoad_ = false;
+        m_ui.getAnimationManPtr()->clearAllProtectionMarks();
+    });
+    m_ui.playTimeline(loadTimeline_, PROTECTION::PROTECTED);
 }
 
 /*
@@ -104,7 +91,7 @@ void ListView::updateScrollPosition() {
     
     if (newTopIndex != topVisibleIndex_) {
         int32_t targetScrollOffset = -newTopIndex * (FontHeight + spacing_);
-        m_ui.animate(scrollOffset_, targetScrollOffset, 350, EasingType::EASE_OUT_CUBIC, PROTECTION::PROTECTED);
+        m_ui.spring(scrollOffset_, targetScrollOffset, 350, PROTECTION::PROTECTED);
         topVisibleIndex_ = newTopIndex;
     }
 }
@@ -119,23 +106,58 @@ void ListView::scrollToTarget(size_t target){
     updateScrollPosition();
     
     U8G2& u8g2 = m_ui.getU8G2();
+    u8g2.setFont(u8g2_font_squeezed_b6_tr);
+    const ListItem& item = m_itemList[currentCursor];
     int screenCursorIndex = currentCursor - topVisibleIndex_;
     int32_t targetCursorY = topMargin_ + screenCursorIndex * (FontHeight + spacing_) - 1;
     
     //  Y coordinate of the cursor 
-    m_ui.animate(CursorY, targetCursorY, 150, EasingType::EASE_IN_OUT_CUBIC);
-    // Width of the cursor
-    m_ui.animate(CursorWidth, u8g2.getUTF8Width(m_itemList[currentCursor].Title) + 6, 500, EasingType::EASE_OUT_CUBIC);
+    m_ui.spring(CursorY, targetCursorY, 150);
+    // Width of the cursor, a title wider than its row scrolls inside it
+    int32_t titleWidth = std::min<int32_t>(m_ui.getTextMetrics().getUTF8Width(item.Title), titleRight(item) - TITLE_X);
+    m_ui.animate(CursorWidth, titleWidth + 6, 500, EasingType::EASE_OUT_CUBIC);
     // Top of the progress bar
     m_ui.animate(progress_bar_top, ((int64_t)currentCursor * 64) / (m_itemLength + 1) + 1, 400, EasingType::EASE_OUT_CUBIC, PROTECTION::PROTECTED); // 修正为定点数运算
     // Bottom of the progress bar
     m_ui.animate(progress_bar_bottom, ((int64_t)1 * 64) / (m_itemLength + 1), 400, EasingType::EASE_OUT_CUBIC, PROTECTION::PROTECTED); // 修正为定点数运算
+
+    restartMarquee();
+}
+
+/*
+@brief Right edge of an item's title: the value column if the item has one, else the scroll bar.
+*/
+int32_t ListView::titleRight(const ListItem& item) const {
+    int32_t width = m_ui.getU8G2().getDisplayWidth();
+    if (item.extra.switchValue || item.extra.intValue) return width - VALUE_COLUMN_WIDTH - 2;
+    return width - 6;
+}
+
+/*
+@brief Scroll the selected title to its end and back, pausing at either end, if it does not fit its row.
+The current font has to be the list font.
+*/
+void ListView::restartMarquee() {
+    m_ui.stopTimeline(marqueeTimeline_);
+    marqueeTimeline_.clear();
+    marqueeOffset_ = 0;
+
+    const ListItem& item = m_itemList[currentCursor];
+    int32_t y = calculateItemY(currentCursor) - scrollOffset_;
+    marqueeBox_ = {TITLE_X, y - FontHeight - 1, titleRight(item) - TITLE_X, FontHeight + 4};
+    marqueeWidth_ = marquee_.setText(item.Title);
+    int32_t overflow = marqueeWidth_ - (titleRight(item) - TITLE_X);
+    if (overflow <= 0) return;
+
+    uint32_t duration = overflow * 1000 / LISTVIEW_MARQUEE_SPEED;
+    marqueeTimeline_.add(marqueeOffset_, overflow, duration, EasingType::LINEAR, LISTVIEW_MARQUEE_PAUSE_MS)
+        .then(LISTVIEW_MARQUEE_PAUSE_MS)
+        .add(marqueeOffset_, 0, 300, EasingType::EASE_IN_OUT_CUBIC)
+        .onComplete([this]() { m_ui.playTimeline(marqueeTimeline_); });
+    m_ui.playTimeline(marqueeTimeline_);
 }
 
 void ListView::navigateUp() {
-    if (currentCursor != 0) {
-        clearNonInitialAnimations();
-    }
     if (currentCursor > 0) {
         currentCursor--;
         scrollToTarget(currentCursor);
@@ -143,9 +165,6 @@ void ListView::navigateUp() {
 }
 
 void ListView::navigateDown() {
-    if (currentCursor != m_itemLength) {
-        clearNonInitialAnimations();
-    }
     if (currentCursor < m_itemLength) {
         currentCursor++;
         scrollToTarget(currentCursor);
@@ -178,7 +197,7 @@ void ListView::selectCurrent(){
         return;
     }
     else { 
-        m_ui.getAnimationManPtr()->clear();
+        m_ui.cancelAnimations(this);
         m_history_stack.push_back(etl::make_pair(etl::make_pair(m_itemList, m_itemLength), currentCursor));
         m_itemLength = m_itemList[currentCursor].nextListLength - 1;
         m_itemList = m_itemList[currentCursor].nextList;
@@ -196,7 +215,7 @@ void ListView::selectCurrent(){
 */
 void ListView::returnToPreviousContext() {
     if (!m_history_stack.empty()){
-        m_ui.getAnimationManPtr()->clear(); // stop all animations
+        m_ui.cancelAnimations(this); // stop all animations of this list, popups keep theirs
         etl::pair<etl::pair<ListItem*, size_t>, size_t> parent_state = m_history_stack.back(); // get the last state
         m_history_stack.pop_back(); // remove it from the stack
         // extract the ListItem* and length
@@ -240,9 +259,53 @@ void ListView::drawCursor() {
     u8g2.setDrawColor(1);
 
     if (!currentCursor)
-        u8g2.drawStr(u8g2.getDisplayWidth() - u8g2.getUTF8Width("BACK") - 5, u8g2.getDisplayHeight() - 5, "BACK");
+        m_ui.getGlyphCache().drawStr(u8g2.getDisplayWidth() - m_ui.getTextMetrics().getStaticUTF8Width("BACK") - 5, u8g2.getDisplayHeight() - 5, "BACK");
     else
-        u8g2.drawStr(u8g2.getDisplayWidth() - u8g2.getUTF8Width(">>") - 5, u8g2.getDisplayHeight() - 5, ">>");
+        m_ui.getGlyphCache().drawStr(u8g2.getDisplayWidth() - m_ui.getTextMetrics().getStaticUTF8Width(">>") - 5, u8g2.getDisplayHeight() - 5, ">>");
+}
+
+/*
+@brief Draw a title within its row. The selected title scrolls through a clip window if it is
+too wide, the others are cut at a glyph boundary and end in "...".
+*/
+void ListView::drawTitle(const ListItem& item, bool selected, int32_t x, int32_t y) {
+    TextMetrics& metrics = m_ui.getTextMetrics();
+    GlyphCache& glyphs = m_ui.getGlyphCache();
+    int32_t right = titleRight(item);
+    if (metrics.getUTF8Width(item.Title) <= right - x) {
+        glyphs.drawStr(x, y, item.Title);
+        return;
+    }
+
+    if (!selected) {
+        int32_t room = right - x - metrics.getStaticStrWidth("...");
+        size_t length = metrics.fitUTF8(item.Title, std::max<int32_t>(room, 0));
+        u8g2_uint_t width = glyphs.drawUTF8(x, y, item.Title, length);
+        glyphs.drawStr(x + width, y, "...");
+        return;
+    }
+
+    // narrow the clip window the renderer set to the title column, then put it back
+    U8G2& u8g2 = m_ui.getU8G2();
+    u8g2_t* raw = u8g2.getU8g2();
+    u8g2_uint_t clipX0 = raw->clip_x0, clipY0 = raw->clip_y0, clipX1 = raw->clip_x1, clipY1 = raw->clip_y1;
+    int32_t left = std::max<int32_t>(x, clipX0);
+    right = std::min<int32_t>(right, clipX1);
+    if (left >= right) return;
+
+    u8g2.setClipWindow(left, clipY0, right, clipY1);
+    marquee_.draw(x - marqueeOffset_, y);
+    u8g2.setClipWindow(clipX0, clipY0, clipX1, clipY1);
+}
+
+/*
+@brief Re-rasterize the selected title if it was edited in place, restarting the marquee if its width changed.
+*/
+void ListView::update(uint32_t /*currentTime*/) {
+    m_ui.getU8G2().setFont(u8g2_font_squeezed_b6_tr);
+    if (marquee_.setText(m_itemList[currentCursor].Title) != marqueeWidth_) {
+        restartMarquee();
+    }
 }
 
 void ListView::onResume() {
@@ -254,7 +317,6 @@ void ListView::onPause() {}
 
 void ListView::onExit() {
     m_ui.markFading();
-    m_ui.setContinousDraw(false);
     m_ui.getAnimationManPtr()->clearAllProtectionMarks();
 }
 
@@ -268,31 +330,33 @@ void ListView::draw(){
     for (int itemIndex = startIndex; itemIndex <= endIndex; itemIndex++) {
         int32_t itemY = calculateItemY(itemIndex);
         
-        if (itemY >= -FontHeight && itemY <= u8g2.getDisplayHeight() + FontHeight) {
-            int32_t drawX = 4;
+        // rows outside the current page or clip window are skipped, not just dropped by u8g2
+        if (itemY >= -FontHeight && itemY <= u8g2.getDisplayHeight() + FontHeight
+            && m_ui.isAreaVisible(0, itemY - FontHeight - 1, u8g2.getDisplayWidth(), FontHeight + 4)) {
+            int32_t drawX = TITLE_X;
             
             if (isInitialLoad_) {
                 int animIndex = itemIndex - topVisibleIndex_;
                 if (animIndex >= 0 && animIndex < visibleItemCount_ + 1) {
                     int32_t loadProgress = itemLoadAnimations_[animIndex];
-                    drawX = 4 + (FIXED_POINT_ONE - loadProgress) * 30 / FIXED_POINT_ONE;
+                    drawX = TITLE_X + (FIXED_POINT_ONE - loadProgress) * 30 / FIXED_POINT_ONE;
                 }
             }
-            u8g2.drawStr(drawX, itemY, m_itemList[itemIndex].Title);
+            drawTitle(m_itemList[itemIndex], itemIndex == (int)currentCursor, drawX, itemY);
             
             if (m_itemList[itemIndex].extra.switchValue) {
                 u8g2.drawRFrame(u8g2.getDisplayWidth() - 35, itemY - 6, 14, 7, 1);
                 u8g2.drawRBox(u8g2.getDisplayWidth() - 35 + switchBoxX, itemY - 6, 7, 7, 2);
                 if (*m_itemList[itemIndex].extra.switchValue)
-                    u8g2.drawStr(u8g2.getDisplayWidth() - 18, itemY, "ON");
+                    m_ui.getGlyphCache().drawStr(u8g2.getDisplayWidth() - 18, itemY, "ON");
                 else 
-                    u8g2.drawStr(u8g2.getDisplayWidth() - 18, itemY, "OFF");
+                    m_ui.getGlyphCache().drawStr(u8g2.getDisplayWidth() - 18, itemY, "OFF");
             }
 
             if (m_itemList[itemIndex].extra.intValue) {
                 char buf[5] = {0};
                 snprintf(buf, 5, "%d", *m_itemList[itemIndex].extra.intValue);
-                u8g2.drawStr(u8g2.getDisplayWidth() - 18, itemY, buf);
+                m_ui.getGlyphCache().drawStr(u8g2.getDisplayWidth() - 18, itemY, buf);
             }
         }
     }
@@ -303,4 +367,73 @@ void ListView::draw(){
 
 int ListView::getVisibleItemIndex(int screenIndex) {
     return topVisibleIndex_ + screenIndex;
+}
+
+/*
+@brief Snapshot of everything draw() depends on.
+*/
+ListView::DrawnState ListView::captureDrawnState() const {
+    DrawnState state;
+    state.itemList = m_itemList;
+    state.itemLength = m_itemLength;
+    state.scrollOffset = scrollOffset_;
+    state.loading = isInitialLoad_;
+    state.switchBoxX = switchBoxX;
+    state.cursorY = CursorY;
+    state.cursorWidth = CursorWidth;
+    state.cursor = currentCursor;
+    state.barTop = progress_bar_top;
+    state.barBottom = progress_bar_bottom;
+    state.marqueeOffset = marqueeOffset_;
+    state.marquee = marqueeTimeline_.isPlaying();
+
+    // same row range as draw()
+    int startIndex = std::max(0, topVisibleIndex_ - 2);
+    int endIndex = std::min((int)m_itemLength, topVisibleIndex_ + visibleItemCount_ + 2);
+    for (int itemIndex = startIndex; itemIndex <= endIndex; itemIndex++) {
+        const ListItem& item = m_itemList[itemIndex];
+        for (const char* c = item.Title; *c; c++) state.titleHash = state.titleHash * 31 + (uint8_t)*c;
+        state.titleHash = state.titleHash * 31 + 1;
+        if (item.extra.switchValue) state.valueHash = state.valueHash * 31 + *item.extra.switchValue;
+        if (item.extra.intValue) state.valueHash = state.valueHash * 31 + (uint32_t)*item.extra.intValue;
+        state.valueHash = state.valueHash * 31 + 1;
+    }
+    return state;
+}
+
+/*
+@brief Report the parts of the list that changed since the last frame.
+Scrolling, loading and list changes move every row and need a full redraw, as does moving
+the cursor to or from a title that scrolls, which switches between scrolling and "...". Otherwise only
+the band the cursor moved through, the scrolling title and the value column on the right can change.
+@param damage receives the changed rectangles.
+@return false if the whole list has to be redrawn.
+*/
+bool ListView::getDamage(DamageList& damage) {
+    DrawnState now = captureDrawnState();
+    DrawnState last = drawn_;
+    bool hadFrame = hasDrawn_;
+    drawn_ = now;
+    hasDrawn_ = true;
+
+    if (!hadFrame || now.loading || last.loading || now.itemList != last.itemList || now.itemLength != last.itemLength
+        || now.scrollOffset != last.scrollOffset || now.titleHash != last.titleHash
+        || (now.cursor != last.cursor && (now.marquee || last.marquee))) {
+        return false;
+    }
+
+    U8G2& u8g2 = m_ui.getU8G2();
+    if (now.cursorY != last.cursorY || now.cursorWidth != last.cursorWidth) {
+        int32_t top = std::min(now.cursorY, last.cursorY);
+        int32_t bottom = std::max(now.cursorY, last.cursorY) + FontHeight + 2;
+        damage.push_back({CursorX, top, std::max(now.cursorWidth, last.cursorWidth), bottom - top});
+    }
+    if (now.marqueeOffset != last.marqueeOffset) {
+        damage.push_back({marqueeBox_.x, marqueeBox_.y + now.scrollOffset, marqueeBox_.w, marqueeBox_.h});
+    }
+    if (now.cursor != last.cursor || now.valueHash != last.valueHash || now.switchBoxX != last.switchBoxX
+        || now.barTop != last.barTop || now.barBottom != last.barBottom) {
+        damage.push_back({u8g2.getDisplayWidth() - VALUE_COLUMN_WIDTH, 0, VALUE_COLUMN_WIDTH, u8g2.getDisplayHeight()});
+    }
+    return true;
 }
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #include "ui/Popup/Popup.h"
 #include "PixelUI.h"
+#include "core/blit/blitter.h"
 #include <cstring>
 #include <algorithm>
 
@@ -161,35 +162,50 @@ bool PopupBase::handleInput(InputEvent event) {
 void PopupBase::draw() {
     U8G2& u8g2 = m_ui.getU8G2();
     
-    int16_t screenWidth = u8g2.getDisplayWidth();
-    int16_t screenHeight = u8g2.getDisplayHeight();
-    int16_t centerX = screenWidth / 2;
-    int16_t centerY = screenHeight / 2;
+    int16_t centerX = u8g2.getDisplayWidth() / 2;
+    int16_t centerY = u8g2.getDisplayHeight() / 2;
     
-    // Get the current dimensions from the animated size.
-    int16_t currentWidth = _currentBoxSize >> 12;
-    if (currentWidth <= 0) return;
-    
-    // Maintain the aspect ratio during animation.
-    int16_t currentHeight = (_width > 0) ? (currentWidth * _height) / _width : 0;
-    
-    // Calculate the top-left corner of the popup box.
-    int16_t rectX = centerX - currentWidth / 2;
-    int16_t rectY = centerY - currentHeight / 2;
+    FocusBox box;
+    if (!getBounds(box)) return;
     
     // Use a clip window to prevent drawing outside the popup's bounds during animation.
-    setupClipWindow(rectX, rectY, currentWidth, currentHeight);
+    setupClipWindow(box.x, box.y, box.w, box.h);
     
     // Draw the popup box
-    drawPopupBox(rectX, rectY, currentWidth, currentHeight);
+    drawPopupBox(box.x, box.y, box.w, box.h);
     
     // Let subclass draw its content
-    drawContent(centerX, centerY, currentWidth, currentHeight);
+    drawContent(centerX, centerY, box.w, box.h);
     
     // Reset the clip window after drawing is complete.
     resetClipWindow();
 }
 
+/**
+ * @brief Gets the box the popup occupies at its current animated size.
+ *
+ * Every pixel inside is drawn by the popup: the border is set and the interior
+ * cleared before the content goes on top.
+ * @return False while the box has no width.
+ */
+bool PopupBase::getBounds(FocusBox& area) const {
+    U8G2& u8g2 = m_ui.getU8G2();
+    
+    // Get the current dimensions from the animated size.
+    int16_t currentWidth = _currentBoxSize >> 12;
+    if (currentWidth <= 0) return false;
+    
+    // Maintain the aspect ratio during animation.
+    int16_t currentHeight = (_width > 0) ? (currentWidth * _height) / _width : 0;
+    
+    // Centered on the screen.
+    area.x = u8g2.getDisplayWidth() / 2 - currentWidth / 2;
+    area.y = u8g2.getDisplayHeight() / 2 - currentHeight / 2;
+    area.w = currentWidth;
+    area.h = currentHeight;
+    return true;
+}
+
 // --- PopupInfo Class Implementation ---
 
 /**
@@ -205,11 +221,11 @@ void PopupBase::draw() {
  */
 PopupInfo::PopupInfo(PixelUI& ui, uint16_t width, uint16_t height, 
                      const char* text, const char* title, uint16_t duration, uint8_t priority)
-    : PopupBase(ui, width, height, priority, duration), _title(title), _text(text), _lineCount(0)
+    : PopupBase(ui, width, height, priority, duration), _title(title), _text(text), _layout(ui), _lineCount(0)
 {
-    // Split text into lines and calculate actual height needed
+    // Wrap the text and calculate the actual height needed
     if (_text) {
-        _lineCount = splitTextIntoLines(_text, _width - 2 * TEXT_MARGIN);
+        _lineCount = layoutText();
         _actualHeight = _lineCount * LINE_HEIGHT + 2 * TEXT_MARGIN;
         
         // Update height if calculated height is different
@@ -223,64 +239,15 @@ PopupInfo::PopupInfo(PixelUI& ui, uint16_t width, uint16_t height,
 }
 
 /**
- * @brief Splits a string into multiple lines to fit within a maximum width.
+ * @brief Wraps the text to the popup width, as many lines as fit on the display.
+ * Called once from the constructor, the text and the width do not change afterwards.
  * @return The number of lines.
  */
-uint16_t PopupInfo::splitTextIntoLines(const char* text, uint16_t maxWidth) {
-    if (!text) return 0;
-    
+uint16_t PopupInfo::layoutText() {
     U8G2& u8g2 = m_ui.getU8G2();
     u8g2.setFont(u8g2_font_5x7_tr);
-    
-    const char* current = text;
-    uint16_t lineIndex = 0;
-    
-    // ESP32-C6 optimization: add max processing length limit to prevent infinite loops
-    const char* textEnd = text + strnlen(text, 512); // Process up to 512 characters
-    
-    while (*current && current < textEnd && lineIndex < MAX_LINES) {
-        const char* lineStart = current;
-        const char* lastSpace = nullptr;
-        const char* lineEnd = current;
-        uint16_t currentLineWidth = 0;
-
-        // Find the best break point for this line
-        while (*lineEnd && lineEnd < textEnd) {
-            // Simple width estimation for performance
-            currentLineWidth += 6; // Assume avg 6 pixels per char for 5x7 font
-
-            if (currentLineWidth > maxWidth) {
-                break; // Line is too long
-            }
-
-            if (*lineEnd == ' ') {
-                lastSpace = lineEnd;
-            }
-            if (*lineEnd == '\n') {
-                lineEnd++;
-                break;
-            }
-            lineEnd++;
-        }
-
-        if (currentLineWidth > maxWidth && lastSpace > lineStart) {
-            lineEnd = lastSpace + 1;
-        }
-        
-        // Store line information
-        _textLines[lineIndex].start = lineStart;
-        _textLines[lineIndex].length = lineEnd - lineStart;
-        
-        // Move to the start of the next line
-        current = lineEnd;
-        while (*current == ' ' || *current == '\n') {
-            current++;
-        }
-        
-        lineIndex++;
-    }
-    
-    return lineIndex;
+    uint16_t maxLines = std::max<int>(1, (u8g2.getDisplayHeight() - 2 * TEXT_MARGIN) / LINE_HEIGHT);
+    return _layout.layout(_text, _width - 2 * TEXT_MARGIN, maxLines);
 }
 
 /**
@@ -290,28 +257,21 @@ void PopupInfo::drawContent(int16_t centerX, int16_t centerY, int16_t currentWid
     // Draw the wrapped text inside the popup.
     if (_text && _lineCount > 0) {
         U8G2& u8g2 = m_ui.getU8G2();
-        u8g2.setFont(u8g2_font_5x7_tr);
+        u8g2.setFont(u8g2_font_5x7_tr); // the font the text was laid out in
         
         int16_t textAreaHeight = _lineCount * LINE_HEIGHT;
         int16_t textStartY = centerY - textAreaHeight / 2 + LINE_HEIGHT - 2;
         
         for (uint16_t i = 0; i < _lineCount; i++) {
-            if (_textLines[i].length > 0) {
-                constexpr size_t MAX_LINE_BUFFER = 64; // Limit single line to 64 chars
-                char lineStr[MAX_LINE_BUFFER];
-                
-                size_t copyLength = std::min((size_t)_textLines[i].length, MAX_LINE_BUFFER - 1);
-                strncpy(lineStr, _textLines[i].start, copyLength);
-                lineStr[copyLength] = '\0';
-                
+            const TextSpan& line = _layout.getLine(i);
+            if (line.length > 0) {
                 // Center the line horizontally.
-                int16_t lineWidth = u8g2.getStrWidth(lineStr);
-                int16_t lineX = centerX - lineWidth / 2;
+                int16_t lineX = centerX - line.width / 2;
                 int16_t lineY = textStartY + (i * LINE_HEIGHT);
                 
                 // Boundary check: ensure text is within the display area
                 if (lineY > 0 && lineY < u8g2.getDisplayHeight()) {
-                    u8g2.drawStr(lineX, lineY, lineStr);
+                    _layout.drawSpan(lineX, lineY, line);
                 }
             }
         }
@@ -336,7 +296,7 @@ void PopupInfo::drawContent(int16_t centerX, int16_t centerY, int16_t currentWid
 PopupProgress::PopupProgress(PixelUI& ui, uint16_t width, uint16_t height,
                              int32_t& value, int32_t minValue, int32_t maxValue,
                              const char* title, uint16_t duration, uint8_t priority)
-    : PopupBase(ui, width, height, priority, duration), _value(value), _minValue(minValue),
+    : PopupBase(ui, width, height, priority, duration), _value(value), _drawnValue(value), _minValue(minValue),
       _maxValue(maxValue), _title(title)
 {
     // Only do necessary safety checks, don't force change user parameters
@@ -400,8 +360,8 @@ void PopupProgress::drawContent(int16_t centerX, int16_t centerY, int16_t curren
 
     // Draw title if there's space and title exists
     if (_title && strlen(_title) > 0 && availableHeight >= 9) {
-        int16_t titleWidth = u8g2.getStrWidth(_title);
-        u8g2.drawStr(centerX - titleWidth / 2, currentY + 7, _title);
+        int16_t titleWidth = m_ui.getTextMetrics().getStrWidth(_title);
+        m_ui.getGlyphCache().drawStr(centerX - titleWidth / 2, currentY + 7, _title);
         currentY += 11;
         availableHeight -= 11;
     }
@@ -432,8 +392,8 @@ void PopupProgress::drawContent(int16_t centerX, int16_t centerY, int16_t curren
         char valueStr[BUFFER_SIZE];
         // Format the value as a percentage.
         formatValueAsPercentage(valueStr, sizeof(valueStr)); 
-        int16_t valueWidth = u8g2.getStrWidth(valueStr);
-        u8g2.drawStr(centerX - valueWidth / 2, currentY + 7, valueStr);
+        int16_t valueWidth = m_ui.getTextMetrics().getStrWidth(valueStr);
+        m_ui.getGlyphCache().drawStr(centerX - valueWidth / 2, currentY + 7, valueStr);
     }
 }
 
@@ -455,6 +415,7 @@ void PopupManager::addPopup(std::shared_ptr<IPopup> popup) {
                     minPriorityIt = it;
                 }
             }
+            m_ui.cancelAnimations(minPriorityIt->get());
             _popups.erase(minPriorityIt);
         }
     }
@@ -467,6 +428,7 @@ void PopupManager::addPopup(std::shared_ptr<IPopup> popup) {
         }
     }
     _popups.insert(insertPos, popup);
+    _cacheValid = false;
 }
 
 /**
@@ -477,7 +439,10 @@ void PopupManager::removePopup(std::shared_ptr<IPopup> popup) {
     
     auto it = std::find(_popups.begin(), _popups.end(), popup);
     if (it != _popups.end()) {
+        m_ui.cancelAnimations(it->get());
         _popups.erase(it);
+        _cacheValid = false;
+        m_ui.markDirty();
     }
 }
 
@@ -485,19 +450,99 @@ void PopupManager::removePopup(std::shared_ptr<IPopup> popup) {
  * @brief Clears all popups from the manager.
  */
 void PopupManager::clearPopups() {
+    for (const auto& popup : _popups) {
+        m_ui.cancelAnimations(popup.get());
+    }
     _popups.clear();
+    _cacheValid = false;
+    m_ui.markDirty();
 }
 
 /**
  * @brief Draws all popups, from lowest to highest priority.
+ *
+ * A single settled popup is drawn once; its pixels are kept and copied back on
+ * later frames, so redrawing the screen below it no longer re-renders the popup.
  */
 void PopupManager::drawPopups() {
+    U8G2& u8g2 = m_ui.getU8G2();
+    const size_t stride = (size_t)u8g2.getBufferTileWidth() * 8;
+
+    if (isCached()) {
+        const FocusBox& a = _cacheArea;
+        for (int32_t page = a.y / 8; page * 8 < a.y + a.h; ++page) {
+            int32_t top = std::max<int32_t>(a.y - page * 8, 0);
+            int32_t bottom = std::min<int32_t>(a.y + a.h - page * 8, 8);
+            uint8_t keep = (uint8_t)~((0xFF << top) & (0xFF >> (8 - bottom))); // rows outside the popup
+            Blitter::blend(u8g2.getBufferPtr() + page * stride + a.x,
+                           _cache.get() + (page - a.y / 8) * a.w, a.w, keep, keep);
+        }
+        return;
+    }
+
     // Draw from lowest priority to highest, so highest is on top
     for (auto it = _popups.rbegin(); it != _popups.rend(); ++it) {
         if (*it) {
             (*it)->draw();
         }
     }
+
+    FocusBox area;
+    _cacheValid = getCacheableArea(area);
+    if (!_cacheValid) return;
+
+    int32_t firstPage = area.y / 8;
+    int32_t pages = (area.y + area.h + 7) / 8 - firstPage;
+    size_t size = (size_t)area.w * pages;
+    if (size > _cacheCapacity) {
+        _cache.reset(new uint8_t[size]);
+        _cacheCapacity = size;
+    }
+    for (int32_t p = 0; p < pages; ++p) {
+        Blitter::copy(_cache.get() + p * area.w, u8g2.getBufferPtr() + (firstPage + p) * stride + area.x, area.w);
+    }
+    _cacheArea = area;
+}
+
+/**
+ * @brief Finds the on-screen area of a popup whose pixels can be kept between frames.
+ *
+ * Only a lone settled popup qualifies, and only with a full frame buffer to copy from.
+ */
+bool PopupManager::getCacheableArea(FocusBox& area) const {
+    if (_popups.size() != 1 || !_popups.front()->isSettled() || m_ui.isPageBufferMode()) return false;
+    if (!_popups.front()->getBounds(area)) return false;
+
+    U8G2& u8g2 = m_ui.getU8G2();
+    int32_t x0 = std::max<int32_t>(area.x, 0);
+    int32_t y0 = std::max<int32_t>(area.y, 0);
+    int32_t x1 = std::min<int32_t>(area.x + area.w, u8g2.getDisplayWidth());
+    int32_t y1 = std::min<int32_t>(area.y + area.h, u8g2.getDisplayHeight());
+    if (x0 >= x1 || y0 >= y1) return false;
+    area = {x0, y0, x1 - x0, y1 - y0};
+    return true;
+}
+
+bool PopupManager::isCached() const {
+    FocusBox area;
+    return _cacheValid && getCacheableArea(area) && area == _cacheArea;
+}
+
+void PopupManager::onFrameRendered() {
+    for (const auto& popup : _popups) {
+        if (popup) popup->onFrameRendered();
+    }
+}
+
+bool PopupManager::getOccludedArea(FocusBox& area) const {
+    bool found = false;
+    for (const auto& popup : _popups) {
+        FocusBox box;
+        if (!popup || !popup->getBounds(box)) continue;
+        if (!found || box.w * box.h > area.w * area.h) area = box;
+        found = true;
+    }
+    return found;
 }
 
 /**
@@ -508,15 +553,24 @@ void PopupManager::updatePopups(uint32_t currentTime) {
         return;
     }
 
+    // Each popup animates in its own scope, so views can reset their animations without cutting it off
+    auto animations = m_ui.getAnimationManPtr();
+    AnimationScope scope = animations->getScope();
+
     // Use a safer iteration method to allow for removal during iteration
     auto it = _popups.begin();
     while (it != _popups.end()) {
+        animations->setScope(it->get());
         if (*it && (*it)->update(currentTime)) {
             ++it;
         } else {
+            animations->cancel(it->get());
             it = _popups.erase(it);
+            _cacheValid = false;
+            m_ui.markDirty(); // uncover what was below
         }
     }
+    animations->setScope(scope);
 }
 
 /**
@@ -527,5 +581,9 @@ bool PopupManager::handleTopPopupInput(InputEvent event) {
     if (_popups.empty()) return false;
     
     // The highest priority popup is at the front of the sorted vector
-    return _popups.front()->handleInput(event);
+    auto animations = m_ui.getAnimationManPtr();
+    AnimationScope scope = animations->setScope(_popups.front().get());
+    bool handled = _popups.front()->handleInput(event);
+    animations->setScope(scope);
+    return handled;
 }
\ No newline at end of file
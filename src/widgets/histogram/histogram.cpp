@@ -23,6 +23,7 @@ Histogram::Histogram(PixelUI& ui) : m_ui(ui) {
 };
 
 void Histogram::onLoad() {
+    m_ui.stopAnimation(m_boxAnimation);
     // 初始化动画坐标为0（相对于原始位置）
     anim_x = 0;
     anim_y = 0;
@@ -65,18 +66,12 @@ void Histogram::expandWidget() {
     calculateExpandPosition(target_x, target_y);
     
     // 动画到展开尺寸和位置
-    m_ui.animate(anim_w, exp_w, 400, EasingType::EASE_OUT_QUAD);
-    m_ui.animate(anim_h, exp_h, 350, EasingType::EASE_OUT_QUAD);
-    m_ui.animate(anim_x, target_x, 400, EasingType::EASE_OUT_QUAD);
-    m_ui.animate(anim_y, target_y, 350, EasingType::EASE_OUT_QUAD);
+    m_ui.animate(m_boxAnimation, {exp_w, exp_h, target_x, target_y}, 400, EasingType::EASE_OUT_QUAD);
 }
 
 void Histogram::contractWidget() {
     // 动画回原始尺寸和位置
-    m_ui.animate(anim_w, margin_w_, 350, EasingType::EASE_OUT_QUAD, PROTECTION::PROTECTED);
-    m_ui.animate(anim_h, margin_h_, 400, EasingType::EASE_OUT_QUAD, PROTECTION::PROTECTED);
-    m_ui.animate(anim_x, 0, 350, EasingType::EASE_OUT_QUAD, PROTECTION::PROTECTED);
-    m_ui.animate(anim_y, 0, 400, EasingType::EASE_OUT_QUAD, PROTECTION::PROTECTED);
+    m_ui.animate(m_boxAnimation, {margin_w_, margin_h_, 0, 0}, 400, EasingType::EASE_OUT_QUAD, PROTECTION::PROTECTED);
 }
 
 void Histogram::calculateExpandPosition(int32_t& target_x, int32_t& target_y) {
@@ -124,12 +119,12 @@ void Histogram::draw() {
     
     u8g2.setDrawColor(1);
     if (is_expanded) {
-        u8g2.clearDisplay();
-        u8g2.drawStr(3, 10, "<STATS>");
-        u8g2.drawStr(3, 20, "Max:");
-        u8g2.drawStr(3, 30, "1.45uSv/h");
-        u8g2.drawStr(3, 40, "Min:");
-        u8g2.drawStr(3, 50, "0.25uSv/h");
+        u8g2.clearBuffer(); // hide what was drawn behind; clearDisplay() would also send a blank frame mid-draw
+        m_ui.getGlyphCache().drawStr(3, 10, "<STATS>");
+        m_ui.getGlyphCache().drawStr(3, 20, "Max:");
+        m_ui.getGlyphCache().drawStr(3, 30, "1.45uSv/h");
+        m_ui.getGlyphCache().drawStr(3, 40, "Min:");
+        m_ui.getGlyphCache().drawStr(3, 50, "0.25uSv/h");
     } 
     u8g2.setDrawColor(0);
     u8g2.drawBox(current_x - half_width + 2, current_y - half_height, 2 * half_width - 4, 2 * half_height);
@@ -194,5 +189,5 @@ void Histogram::draw() {
     
     // 绘制标签
     u8g2.setFont(u8g2_font_4x6_tr);
-    u8g2.drawStr(current_x + half_width - 19, current_y - half_height + 7, "Hist");
+    m_ui.getGlyphCache().drawStr(current_x + half_width - 19, current_y - half_height + 7, "Hist");
 }
\ No newline at end of file
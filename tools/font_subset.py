@@ -0,0 +1,359 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 Lawrence Link
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+"""Crops u8g2 fonts to the glyphs the firmware can draw.
+
+The sources are scanned for string and character literals; printf conversions in
+them ("%d", "%5.2f", "%%", ...) stand for the characters they can print. Every
+u8g2_font_* the sources name is looked up in the u8g2 font sources and rewritten
+with only those code points, plus --keep, under the name pixelui_subset_<font>.
+The build maps the original names onto the cropped arrays.
+
+Glyph data is copied byte for byte, so cropped fonts draw exactly like the
+originals. A code point the original font lacks is reported and left out: u8g2
+skips it when drawing, as it does with the full font. A font that cannot be
+parsed is emitted unchanged, so the build never loses a font.
+
+usage:
+  font_subset.py --list-fonts --font-source PATH... --scan PATH...
+  font_subset.py --fonts NAME... --font-source PATH... --scan PATH... --output FILE.c [--keep CHARS] [--report FILE]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SOURCE_EXTENSIONS = ('.c', '.cc', '.cpp', '.cxx', '.h', '.hh', '.hpp', '.hxx', '.ino')
+HEADER_SIZE = 23  # U8G2_FONT_DATA_STRUCT_SIZE
+
+# characters a printf conversion can produce, by conversion letter
+FORMAT_OUTPUT = {
+    'd': '0123456789-', 'i': '0123456789-', 'u': '0123456789', 'o': '01234567',
+    'x': '0123456789abcdef', 'X': '0123456789ABCDEF',
+    'f': '0123456789.-', 'F': '0123456789.-',
+    'e': '0123456789.-+e', 'E': '0123456789.-+E',
+    'g': '0123456789.-+e', 'G': '0123456789.-+E',
+    'a': '0123456789abcdefpx.-+', 'A': '0123456789ABCDEFPX.-+',
+    'p': '0123456789abcdefx',
+}
+FORMAT_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(?:hh|h|ll|l|j|z|t|L)?([diouxXfFeEgGaAcspn%])')
+ESCAPES = {'n': 10, 't': 9, 'r': 13, 'a': 7, 'b': 8, 'f': 12, 'v': 11,
+           '\\': 92, '"': 34, "'": 39, '?': 63}
+
+
+# -------------------------------
+# Source scanning
+# -------------------------------
+def unescape(body, encoding='utf-8'):
+    """Bytes of a C string literal body, plain characters and universal character
+    names encoded in the given encoding."""
+    out = bytearray()
+    i = 0
+    while i < len(body):
+        c = body[i]
+        if c != '\\' or i + 1 == len(body):
+            out += c.encode(encoding)
+            i += 1
+            continue
+        n = body[i + 1]
+        if n in '01234567':
+            digits = re.match(r'[0-7]{1,3}', body[i + 1:]).group(0)
+            out.append(int(digits, 8) & 0xFF)
+            i += 1 + len(digits)
+        elif n == 'x':
+            digits = re.match(r'[0-9a-fA-F]*', body[i + 2:]).group(0)
+            out.append(int(digits or '0', 16) & 0xFF)
+            i += 2 + len(digits)
+        elif n in 'uU':
+            count = 4 if n == 'u' else 8
+            out += chr(int(body[i + 2:i + 2 + count], 16)).encode(encoding)
+            i += 2 + count
+        else:
+            out.append(ESCAPES.get(n, ord(n)))
+            i += 2
+    return bytes(out)
+
+
+def literals(text):
+    """Yields the decoded string and character literals of a C/C++ source, skipping
+    comments, #include and #pragma lines and digit separators."""
+    i = 0
+    length = len(text)
+    line_start = True
+    while i < length:
+        c = text[i]
+        if line_start and c == '#':
+            directive = re.match(r'#\s*(include|pragma)\b', text[i:])
+            if directive:
+                end = text.find('\n', i)
+                i = length if end < 0 else end
+                continue
+        if c == '\n':
+            line_start = True
+            i += 1
+            continue
+        if not c.isspace():
+            line_start = False
+        if text.startswith('//', i):
+            end = text.find('\n', i)
+            i = length if end < 0 else end
+        elif text.startswith('/*', i):
+            end = text.find('*/', i + 2)
+            i = length if end < 0 else end + 2
+        elif c == 'R' and text.startswith('"', i + 1) and identifier_before(text, i) in ('', 'u8', 'u', 'U', 'L'):
+            m = re.match(r'R"([^ ()\\\t\n]{0,16})\(', text[i:])
+            if not m:
+                i += 1
+                continue
+            close = ')' + m.group(1) + '"'
+            end = text.find(close, i + len(m.group(0)))
+            end = length if end < 0 else end
+            yield text[i + len(m.group(0)):end].encode('utf-8')
+            i = end + len(close)
+        elif c in '"\'':
+            if c == "'" and identifier_before(text, i)[:1].isdigit():
+                i += 1  # 1'000 is a digit separator, u8'x' and L'x' are literals
+                continue
+            j = i + 1
+            while j < length and text[j] != c and text[j] != '\n':
+                j += 2 if text[j] == '\\' else 1
+            yield unescape(text[i + 1:j])
+            i = j + 1
+        else:
+            i += 1
+
+
+def identifier_before(text, i):
+    """The identifier or number token that ends right before position i."""
+    j = i
+    while j and (text[j - 1].isalnum() or text[j - 1] == '_'):
+        j -= 1
+    return text[j:i]
+
+
+def code_points(data):
+    """Printable code points of a literal, with printf conversions expanded."""
+    text = data.decode('utf-8', errors='ignore')
+    points = set()
+    if '%' in text:
+        def expand(m):
+            flags, conversion = m.group(1), m.group(4)
+            if conversion == '%':
+                return '%'
+            output = FORMAT_OUTPUT.get(conversion, '')
+            if output:
+                output += ''.join(f for f in flags if f in '+ ')
+                if conversion in 'fFeEgG' or '#' in flags:
+                    output += 'infa' if conversion.islower() else 'INFA'
+                points.update(ord(ch) for ch in output)
+            return ''
+        text = FORMAT_RE.sub(expand, text)
+    points.update(ord(ch) for ch in text if ord(ch) >= 0x20 and ord(ch) != 0x7F)
+    return points
+
+
+def scan(paths):
+    """Code points of every literal, and every u8g2_font_* name, in the sources."""
+    points = set()
+    names = set()
+    for path in source_files(paths):
+        with open(path, encoding='utf-8', errors='replace') as f:
+            text = f.read()
+        names.update(re.findall(r'\bu8g2_font_\w+', text))
+        for data in literals(text):
+            points |= code_points(data)
+    return points, names
+
+
+def source_files(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, dirs, files in os.walk(path):
+            dirs.sort()
+            for name in sorted(files):
+                if name.endswith(SOURCE_EXTENSIONS):
+                    yield os.path.join(root, name)
+
+
+# -------------------------------
+# u8g2 fonts
+# -------------------------------
+def find_font(name, font_sources):
+    """The bytes of a font array, or None if no font source defines it."""
+    definition = re.compile(r'\b' + re.escape(name) + r'\s*\[\s*\d*\s*\][^=;]*=((?:\s*"(?:[^"\\\n]|\\.)*")+)\s*;')
+    candidates = []
+    for source in font_sources:
+        if os.path.isdir(source):
+            single = os.path.join(source, name + '.c')
+            if os.path.isfile(single):
+                candidates.insert(0, single)
+            candidates += [os.path.join(source, f) for f in sorted(os.listdir(source)) if f == 'u8g2_fonts.c']
+        elif os.path.isfile(source):
+            candidates.append(source)
+    for path in candidates:
+        with open(path, encoding='latin-1') as f:
+            m = definition.search(f.read())
+        if m:
+            body = ''.join(re.findall(r'"((?:[^"\\\n]|\\.)*)"', m.group(1)))
+            return unescape(body, 'latin-1') + b'\0'  # the terminating NUL is part of the font
+    return None
+
+
+def parse_font(data):
+    """Splits a font into its header and glyph records, keyed by code point."""
+    header = data[:HEADER_SIZE]
+    glyphs = {}
+    pos = HEADER_SIZE
+    while data[pos + 1] != 0:  # encoding, record size, glyph bits
+        glyphs[data[pos]] = data[pos:pos + data[pos + 1]]
+        pos += data[pos + 1]
+    pos = HEADER_SIZE + (header[21] << 8 | header[22])
+    while True:  # unicode lookup table: (offset, encoding) pairs up to 0xffff
+        encoding = data[pos + 2] << 8 | data[pos + 3]
+        pos += 4
+        if encoding == 0xFFFF:
+            break
+    while data[pos] << 8 | data[pos + 1]:  # 16 bit encoding, record size, glyph bits
+        glyphs[data[pos] << 8 | data[pos + 1]] = data[pos:pos + data[pos + 2]]
+        pos += data[pos + 2]
+    return header, glyphs
+
+
+def build_font(header, glyphs):
+    """Reassembles a font from glyph records in the layout u8g2_font_get_glyph_data() walks."""
+    body = bytearray()
+    upper_a = lower_a = None
+    for code in sorted(c for c in glyphs if c <= 0xFF):
+        if upper_a is None and code >= ord('A'):
+            upper_a = len(body)
+        if lower_a is None and code >= ord('a'):
+            lower_a = len(body)
+        body += glyphs[code]
+    upper_a = len(body) if upper_a is None else upper_a
+    lower_a = len(body) if lower_a is None else lower_a
+    body += b'\0\0'
+    unicode = len(body)
+    body += bytes([0, 4, 0xFF, 0xFF])  # a single lookup entry, the records are searched linearly
+    for code in sorted(c for c in glyphs if c > 0xFF):
+        body += glyphs[code]
+    body += b'\0\0'
+
+    out = bytearray(header)
+    out[0] = len(glyphs) & 0xFF
+    out[17:19] = upper_a.to_bytes(2, 'big')
+    out[19:21] = lower_a.to_bytes(2, 'big')
+    out[21:23] = unicode.to_bytes(2, 'big')
+    return bytes(out + body)
+
+
+def subset(name, font_sources, points):
+    """Returns (bytes, original size, kept glyphs, total glyphs, missing code points).
+    Only code points inside the range the font covers count as missing, an ASCII
+    font is not expected to have the CJK glyphs another font draws."""
+    data = find_font(name, font_sources)
+    if data is None:
+        return None
+    try:
+        header, glyphs = parse_font(data)
+    except IndexError:
+        print('font_subset: warning: cannot parse %s, keeping it whole' % name, file=sys.stderr)
+        return data, len(data), 0, 0, []
+    kept = {code: glyphs[code] for code in points if code in glyphs}
+    first, last = min(glyphs, default=0), max(glyphs, default=0)
+    missing = sorted(code for code in points if first < code < last and code not in glyphs)
+    return build_font(header, kept), len(data), len(kept), len(glyphs), missing
+
+
+# -------------------------------
+# Output
+# -------------------------------
+def write_c(path, fonts):
+    lines = [
+        '/* Generated by tools/font_subset.py, do not edit. */',
+        '#include "u8g2.h"',
+        '',
+    ]
+    for name, data in fonts:
+        symbol = 'pixelui_subset_' + name
+        lines.append('const uint8_t %s[%d] U8G2_FONT_SECTION("%s") = {' % (symbol, len(data), symbol))
+        for i in range(0, len(data), 16):
+            lines.append('    ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+        lines.append('};')
+        lines.append('')
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines))
+
+
+def describe(code):
+    return 'U+%04X' % code if code > 0x7E else repr(chr(code))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Crops u8g2 fonts to the glyphs the sources use.')
+    parser.add_argument('--font-source', nargs='+', required=True,
+                        help='u8g2 font directories (single_font_files/, csrc/) or files')
+    parser.add_argument('--scan', nargs='+', required=True, help='source directories or files to scan')
+    parser.add_argument('--list-fonts', action='store_true',
+                        help='print the fonts the sources use that can be cropped, separated by ";"')
+    parser.add_argument('--fonts', nargs='*', default=[], help='fonts to crop')
+    parser.add_argument('--keep', default='', help='characters every cropped font keeps, e.g. for runtime text')
+    parser.add_argument('--output', help='generated C file')
+    parser.add_argument('--report', help='also write the size report to this file')
+    args = parser.parse_args()
+
+    points, names = scan(args.scan)
+    points.update(ord(ch) for ch in args.keep)
+
+    if args.list_fonts:
+        usable = [n for n in sorted(names) if find_font(n, args.font_source) is not None]
+        sys.stdout.write(';'.join(usable))
+        return 0
+
+    if not args.output:
+        parser.error('--output is required unless --list-fonts is given')
+
+    fonts = []
+    report = []
+    saved_total = 0
+    for name in args.fonts:
+        result = subset(name, args.font_source, points)
+        if result is None:
+            print('font_subset: error: %s not found in %s' % (name, ' '.join(args.font_source)), file=sys.stderr)
+            return 1
+        data, original, kept, total, missing = result
+        fonts.append((name, data))
+        saved = original - len(data)
+        saved_total += saved
+        report.append('%-36s %4d/%-4d glyphs %7d -> %6d bytes, %6d saved' % (name, kept, total, original, len(data), saved))
+        if missing:
+            report.append('    not in the font: ' + ' '.join(describe(c) for c in missing))
+    report.append('%-36s %33s %6d saved' % ('total', '', saved_total))
+
+    write_c(args.output, fonts)
+    text = '\n'.join(report) + '\n'
+    sys.stdout.write(text)
+    if args.report:
+        with open(args.report, 'w', encoding='utf-8') as f:
+            f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())